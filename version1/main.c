@@ -6,14 +6,69 @@
  * @date 2022-12-19
  */
 
+#define _POSIX_C_SOURCE 200809L  // clock_gettime, sysconf, fork, pipe et getrusage avec -std=c17
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include <MLV/MLV_all.h>
 #include <time.h>
 #include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #define M_PI 3.14159265358979323846
+#define ERREUR_ORIENTATION ((3.0 + 8.0 * DBL_EPSILON) * DBL_EPSILON / 2)  // Borne d'erreur relative du calcul flottant de orientation
 #define BLOC 25
+#define BLOC_VERTEX 64  // Taille du premier bloc de Vertex d'une réserve
+#define BLOC_VERTEX_MAX 4096  // Taille maximale d'un bloc de Vertex
+#define BLOC_POINTS 64  // Nombre de points classés ensemble par masqueExterieur (un bit par point)
+#define POINTS_PAR_THREAD 65536  // Nombre minimal de points confiés à chaque thread du calcul parallèle
+#define BENCHMARK_GRAINE 20221219  // Graine des points générés par le banc d'essai, fixe pour des mesures reproductibles
+#define BENCHMARK_DUREE_MAX 10.0  // Durée en secondes au delà de laquelle un moteur n'est plus mesuré sur les tailles suivantes
+#define RAYON_POINT 2  // Rayon en pixels d'un point de l'ensemble dessiné
+#define IMAGES_PAR_SECONDE 60  // Fréquence maximale des images de l'affichage dynamique
+#define INSERTIONS_PAR_IMAGE 0  // 0 : images cadencées par IMAGES_PAR_SECONDE, k > 0 : une image toutes les k insertions
+#define NOUVEL_INSTANTANE 4  // Bit ajouté à l'indice de l'instantané publié tant que l'affichage ne l'a pas pris
+#define PROFONDEUR_MAX 128  // Profondeur maximale de l'arbre dynamique, équilibré à 3/4 il ne dépasse pas 2,41 log2(n) + 1
+
+// Compteurs d'instrumentation, compilés seulement avec -DCOMPTEURS
+#define COMPTEUR_ORIENTATIONS 0  // Appels à orientation
+#define COMPTEUR_VISITES 1  // Sommets parcourus par la recherche d'un triangle indirect
+#define COMPTEUR_NETTOYAGE_AVANT 2  // Sommets enlevés par le nettoyage avant
+#define COMPTEUR_NETTOYAGE_ARRIERE 3  // Sommets enlevés par le nettoyage arrière
+#define COMPTEUR_VERTEX 4  // Vertex demandés à la réserve
+#define COMPTEUR_MALLOC 5  // Blocs de Vertex alloués par malloc
+#define NB_COMPTEURS 6
+#define NB_CLASSES 33  // Classes des histogrammes : 0, 1, 2-3, 4-7, ..., 2^31 et plus
+
+#ifdef COMPTEURS
+#define COMPTE(compteur) (compteursMaj[compteur]++)
+#else
+#define COMPTE(compteur) ((void)0)
+#endif
+
+// Moteurs de calcul disponibles en mode sans fenêtre
+#define MOTEUR_INCREMENTAL 0  // Ajout point par point avec majEnveloppeConvex
+#define MOTEUR_BATCH 1  // Calcul en une seule fois avec enveloppeConvexeEnsemble
+#define MOTEUR_FLUX 2  // Ajout point par point sans conserver les points lus
+#define MOTEUR_TABLEAU 3  // Ajout point par point avec majEnveloppeConvexTab
+#define MOTEUR_ARBRE 4  // Ajout point par point avec majEnveloppeConvexArbre
+#define MOTEUR_PARALLELE 5  // Calcul en une seule fois réparti sur plusieurs threads avec enveloppeConvexeParallele
+#define MOTEUR_DYNAMIQUE 6  // Ajouts et suppressions de points avec majEnveloppeConvexDynamique
+#define MOTEUR_FENETRE 7  // Enveloppe des derniers points arrivés avec ajouteFenetreConvexHull
 
 /**
  * @brief Coordonnées d'un point en 2 dimension
@@ -34,16 +89,166 @@ typedef struct {
     int maxLen;  // taille du tableau
 } Ensemble;
 
+/**
+ * @brief Bloc de points rangés coordonnée par coordonnée, pour tester 
+ * plusieurs points à la fois contre les mêmes côtés
+ * 
+ */
+typedef struct {
+    double x[BLOC_POINTS];
+    double y[BLOC_POINTS];
+    int nbPoints;  // Nombre de points du bloc
+} BlocPoints;
+
 /**
  * @brief Cellule d'une liste polygone
  * 
  */
 typedef struct _vertex_ {
-    Point *p;  // Un point de l'ensemble
+    Point p;  // Coordonnées du sommet, copiées pour ne pas dépendre de l'ensemble
     struct _vertex_ *prec;  // Le vertex précédent
     struct _vertex_ *suiv;  // Le vertex suivant
 } Vertex, *Polygone;
 
+/**
+ * @brief Bloc de Vertex alloués en une seule fois par une ReserveVertex
+ * 
+ */
+typedef struct _bloc_vertex_ {
+    struct _bloc_vertex_ *suiv;  // Bloc alloué avant celui-ci
+    int taille;  // Nombre de cellules du bloc
+    int nbDistribues;  // Nombre de cellules déjà distribuées
+    Vertex cellules[];  // Cellules contiguës en mémoire
+} BlocVertex;
+
+/**
+ * @brief Réserve de Vertex d'une enveloppe : les cellules sont découpées dans 
+ * des blocs et celles qui sont libérées sont réutilisées en priorité
+ * 
+ */
+typedef struct {
+    BlocVertex *blocs;  // Liste des blocs alloués, le plus récent en tête
+    Vertex *libres;  // Cellules libérées, chaînées par leur champ suiv
+} ReserveVertex;
+
+/**
+ * @brief Polygone rangé dans un tableau circulaire de points, parcouru dans le même 
+ * sens qu'un Polygone : le sommet d'indice k + 1 est le suivant du sommet d'indice k \n
+ * Les places libres forment un trou entre le dernier et le premier sommet
+ * 
+ */
+typedef struct {
+    Point *sommets;  // Tableau circulaire des sommets
+    int debut;  // Position dans le tableau du premier sommet
+    int len;  // Nombre de sommets
+    int maxLen;  // Taille du tableau
+} PolygoneTab;
+
+/**
+ * @brief Noeud d'un arbre binaire de recherche équilibré (tas-arbre) de points rangés dans l'ordre lexicographique
+ * 
+ */
+typedef struct _noeud_chaine_ {
+    Point p;  // Sommet de la chaîne
+    uint64_t priorite;  // Priorité pseudo-aléatoire, plus grande que celles des fils
+    struct _noeud_chaine_ *gauche;  // Sommets placés avant p
+    struct _noeud_chaine_ *droite;  // Sommets placés après p
+} NoeudChaine;
+
+/**
+ * @brief Chaîne supérieure ou inférieure d'une enveloppe, du point le plus à gauche au 
+ * point le plus à droite, dont les sommets sont rangés dans un arbre équilibré
+ * 
+ */
+typedef struct {
+    NoeudChaine *racine;  // Arbre des sommets de la chaîne
+    int len;  // Nombre de sommets de la chaîne
+    int superieure;  // 1 : chaîne supérieure, 0 : chaîne inférieure
+    uint64_t compteur;  // Compteur mélangé par melange64 pour les priorités, sans toucher au flux de rand
+} Chaine;
+
+/**
+ * @brief Noeud d'un arbre équilibré en poids dont les feuilles sont les points distincts de l'ensemble, 
+ * rangés dans l'ordre lexicographique \n
+ * Chaque noeud interne garde le pont qui relie les chaînes de ses deux sous arbres : la chaîne d'un noeud est 
+ * la chaîne de son fils gauche jusqu'au pont suivie de celle de son fils droit à partir du pont
+ * 
+ */
+typedef struct _noeud_dynamique_ {
+    Point p;  // Point d'une feuille
+    int multiplicite;  // Nombre de copies du point d'une feuille
+    int taille;  // Nombre de feuilles du sous arbre
+    Point min;  // Premier point du sous arbre
+    Point max;  // Dernier point du sous arbre
+    Point pont[2][2];  // Pont de la chaîne inférieure (0) et supérieure (1) : extrémité à gauche (0) et à droite (1)
+    int lenGauche[2];  // Nombre de sommets de la chaîne du fils gauche jusqu'au pont compris
+    int lenDroite[2];  // Nombre de sommets de la chaîne du fils droit à partir du pont compris
+    struct _noeud_dynamique_ *gauche;  // Sous arbre des premiers points, NULL pour une feuille
+    struct _noeud_dynamique_ *droite;  // Sous arbre des derniers points, NULL pour une feuille
+} NoeudDynamique;
+
+/**
+ * @brief Point daté par son arrivée dans une fenêtre glissante
+ * 
+ */
+typedef struct {
+    Point p;
+    double date;  // Date d'arrivée du point
+} PointDate;
+
+/**
+ * @brief File des points d'une fenêtre glissante rangée dans un tableau circulaire, du plus ancien au plus récent \n
+ * Un point sort de la fenêtre quand elle en contient trop ou quand il est trop vieux
+ * 
+ */
+typedef struct {
+    PointDate *points;  // Tableau circulaire des points
+    int debut;  // Position dans le tableau du plus ancien point
+    int len;  // Nombre de points de la fenêtre
+    int maxLen;  // Taille du tableau
+    int maxPoints;  // Nombre maximal de points gardés, 0 : pas de limite
+    double duree;  // Âge maximal des points gardés, 0 : pas de limite
+} FenetrePoints;
+
+/**
+ * @brief Résultat d'une mesure du banc d'essai : un moteur sur une distribution et une taille d'ensemble
+ * 
+ */
+typedef struct {
+    double nsParPoint;  // Durée du calcul de l'enveloppe divisée par le nombre de points, en nanosecondes
+    int curlen;  // Nombre de sommets de l'enveloppe
+    int maxlen;
+    float avg;
+    int nbMaj;
+    long memoire;  // Pic de mémoire du processus de mesure, en Ko
+} MesureBenchmark;
+
+/**
+ * @brief Image de la fenêtre dans laquelle les points d'un ensemble sont tamponnés une seule fois chacun, 
+ * puis copiée d'un coup sur la fenêtre à chaque image affichée
+ * 
+ */
+typedef struct {
+    MLV_Image *image;  // Fond de la fenêtre avec les points déjà tamponnés
+    uint8_t *pixels;  // 1 pour un pixel de l'image déjà coloré par un point, il n'est jamais recoloré
+    int largeur;
+    int hauteur;
+    int nbDessines;  // Nombre de points de l'ensemble déjà tamponnés
+    int tampon[(2 * RAYON_POINT + 1) * (2 * RAYON_POINT + 1)][2];  // Décalages des pixels d'un point autour de son centre
+    int lenTampon;  // Nombre de pixels d'un point
+    MLV_Color couleur;  // Couleur des points
+} RenduPoints;
+
+/**
+ * @brief Rectangle qui contient tout ce qu'une mise à jour de l'enveloppe a changé à l'écran
+ * 
+ */
+typedef struct {
+    Point min;  // Coin de plus petites coordonnées
+    Point max;  // Coin de plus grandes coordonnées
+    int vide;  // 1 : le rectangle ne contient encore aucun point
+} ZoneModifiee;
+
 /**
  * @brief Contient un Polygone et plusieurs renseignements utiles (longeur courent, longueur maximal, longueur moyenne)
  * 
@@ -54,8 +259,103 @@ typedef struct {
     int maxlen;  // Nombre de points maximale du polygône
     float avg;   // Nombre de points moyen du polynôme
     int nbMaj;  // Nombre de mise à jour de l'enveloppe
+    int nbRejets;  // Nombre de points rejetés par l'octogone des points extrêmes sans parcourir le polygône
+    Point extremes[8];  // Points extrêmes dans 8 directions, sommets d'un octogone contenu dans l'enveloppe
+    ReserveVertex reserve;  // Réserve dans laquelle sont pris les Vertex du polygône
+    PolygoneTab tab;  // Sommets de l'enveloppe quand elle est rangée dans un tableau (majEnveloppeConvexTab)
+    Chaine sup;  // Chaîne supérieure quand l'enveloppe est rangée dans des arbres (majEnveloppeConvexArbre)
+    Chaine inf;  // Chaîne inférieure quand l'enveloppe est rangée dans des arbres (majEnveloppeConvexArbre)
+    NoeudDynamique *dyn;  // Arbre de tous les points quand l'enveloppe accepte des suppressions (majEnveloppeConvexDynamique)
+    ZoneModifiee zone;  // Point ajouté, sommets enlevés et nouveaux côtés de la dernière mise à jour par majEnveloppeConvex
 } ConvexHull;
 
+/**
+ * @brief Copie figée des sommets d'une enveloppe, lue par l'affichage pendant que le calcul continue
+ * 
+ */
+typedef struct {
+    Point *sommets;  // Sommets de l'enveloppe dans l'ordre du polygône
+    int len;  // Nombre de sommets
+    int maxLen;  // Taille du tableau
+    int nbPoints;  // Nombre de points de l'ensemble déjà ajoutés à l'enveloppe
+    ZoneModifiee zone;  // Zone modifiée depuis l'instantané précédent pris par l'affichage
+} InstantaneEnveloppe;
+
+/**
+ * @brief Trois instantanés échangés sans verrou entre le thread de calcul et celui de l'affichage : 
+ * chacun garde le sien et ils échangent le leur avec l'instantané publié par une opération atomique
+ * 
+ */
+typedef struct {
+    InstantaneEnveloppe tampons[3];
+    atomic_int publie;  // Indice de l'instantané publié, plus NOUVEL_INSTANTANE si l'affichage ne l'a pas encore pris
+    int ecriture;  // Instantané rempli par le thread de calcul
+    int lecture;  // Instantané dessiné par l'affichage
+} PublicationEnveloppe;
+
+/**
+ * @brief Ajouts confiés au thread de calcul de l'affichage dynamique
+ * 
+ */
+typedef struct {
+    Ensemble e;  // Points à ajouter, générés à l'avance
+    ConvexHull *env_convex;  // Enveloppe mise à jour, seul le thread de calcul y touche jusqu'à sa fin
+    PublicationEnveloppe *publication;
+    atomic_int arret;  // Mis à 1 par l'affichage pour arrêter les ajouts
+    atomic_int fini;  // Mis à 1 par le thread de calcul quand il s'arrête
+    int reussite;  // 1 : les ajouts ont réussi, 0 : échec d'une allocation de mémoire
+} TravailInsertion;
+
+/**
+ * @brief Travail confié à un thread du calcul parallèle : l'enveloppe d'une tranche de l'ensemble
+ * 
+ */
+typedef struct {
+    Ensemble e;  // Tranche de l'ensemble, ses points ne sont pas recopiés
+    ConvexHull env_convex;  // Enveloppe partielle de la tranche, avec sa propre réserve de Vertex
+    int reussite;  // 1 : le calcul a réussi, 0 : échec d'une allocation de mémoire
+} TravailEnveloppe;
+
+/**
+ * @brief Paramètres d'une distribution de points générés par generationPoint
+ * 
+ */
+typedef struct {
+    uint64_t graine;  // Graine de la suite de points, le point d'indice k ne dépend que d'elle et de k
+    double centre;  // Centre de la forme
+    double rayon;  // Demi-côté ou rayon de la forme pour le point d'indice 0
+    double pas;  // Croissance du rayon d'un point à l'autre (distribution spirale), 0 sinon
+    int forme;  // 0 : carré, 1 : disque, 2 : cercle
+} Distribution;
+
+/**
+ * @brief Travail confié à un thread de la génération de points : une tranche d'indices de l'ensemble
+ * 
+ */
+typedef struct {
+    Point *points;  // Tableau de l'ensemble rempli
+    int debut;  // Indice du premier point généré
+    int fin;  // Indice après le dernier point généré
+    Distribution d;
+} TravailGeneration;
+
+#ifdef COMPTEURS
+/**
+ * @brief Histogramme des valeurs prises par un compteur d'instrumentation à chaque mise à jour d'une enveloppe
+ * 
+ */
+typedef struct {
+    long classes[NB_CLASSES];  // Nombre de mises à jour par classe, la classe k > 0 va de 2^(k-1) à 2^k - 1
+    long total;  // Somme des valeurs
+    long max;  // Plus grande valeur
+    int majMax;  // Numéro de la mise à jour (nbMaj) qui a donné la plus grande valeur
+} Histogramme;
+
+// Compteurs de la mise à jour en cours et leurs histogrammes, propres à chaque thread
+_Thread_local long compteursMaj[NB_COMPTEURS];
+_Thread_local Histogramme histogrammes[NB_COMPTEURS];
+#endif
+
 // --------------------Fonction de manipulations des points--------------------
 
 /**
@@ -70,18 +370,116 @@ void printListePoint(Point *p, int lenP) {
     }
 }
 
+// ----------------Fonctions de gestion des réserves de Vertex-----------------
+
+/**
+ * @brief Initialise et renvoie une réserve de Vertex vide
+ * 
+ * @return ReserveVertex Réserve initialisée
+ */
+ReserveVertex initReserveVertex(void) {
+    ReserveVertex r;
+    r.blocs = NULL;
+    r.libres = NULL;
+    return r;
+}
+
+/**
+ * @brief Ajoute un bloc de cellules à la réserve **r**, chaque bloc est deux fois 
+ * plus grand que le précédent jusqu'à **BLOC_VERTEX_MAX** cellules
+ * 
+ * @param r Réserve à agrandir
+ * @return int 1 : l'allocation du bloc a réussi \n
+ *             0 : l'allocation du bloc a échoué
+ */
+int ajouteBlocVertex(ReserveVertex *r) {
+    int taille = BLOC_VERTEX;
+    if (r->blocs) {
+        taille = 2 * r->blocs->taille;
+        if (taille > BLOC_VERTEX_MAX) {
+            taille = BLOC_VERTEX_MAX;
+        }
+    }
+
+    COMPTE(COMPTEUR_MALLOC);
+    BlocVertex *bloc = (BlocVertex*)malloc(sizeof(BlocVertex) + taille * sizeof(Vertex));
+    if (!bloc) {
+        return 0;
+    }
+    bloc->taille = taille;
+    bloc->nbDistribues = 0;
+    bloc->suiv = r->blocs;
+    r->blocs = bloc;
+    return 1;
+}
+
+/**
+ * @brief Rend la cellule **v** à la réserve **r** pour qu'elle soit réutilisée
+ * 
+ * @param r Réserve d'où provient la cellule
+ * @param v Cellule rendue
+ */
+void rendVertex(ReserveVertex *r, Vertex *v) {
+    v->suiv = r->libres;
+    r->libres = v;
+}
+
+/**
+ * @brief Libére en une seule fois tous les blocs de la réserve **r**, 
+ * toutes les cellules qui en proviennent deviennent invalides
+ * 
+ * @param r Réserve à vider
+ */
+void libereReserveVertex(ReserveVertex *r) {
+    BlocVertex *tmp;
+    while (r->blocs) {
+        tmp = r->blocs->suiv;
+        free(r->blocs);
+        r->blocs = tmp;
+    }
+    r->libres = NULL;
+}
+
+/**
+ * @brief Compare deux points selon l'ordre lexicographique (x puis y)
+ * 
+ * @param a 
+ * @param b 
+ * @return int -1 : **a** est avant **b** \n
+ *             0 : **a** et **b** sont confondus \n
+ *             1 : **a** est après **b**
+ */
+int ordrePoints(Point a, Point b) {
+    if (a.x != b.x) {
+        return (a.x < b.x) ? -1 : 1;
+    }
+    if (a.y != b.y) {
+        return (a.y < b.y) ? -1 : 1;
+    }
+    return 0;
+}
+
 // ---------------------Fonctions de gestion des Polygones---------------------
 
 /**
- * @brief Alloue et renvoie un pointeur sur une zone mémoire pour un Vertex
+ * @brief Prend une cellule Vertex dans la réserve **r**, une cellule libérée est 
+ * réutilisée en priorité, sinon elle est découpée dans le bloc le plus récent
  * 
- * @param p Addresse du point contenue dans le vertex
+ * @param r Réserve dans laquelle la cellule est prise
+ * @param p Point copié dans le vertex
  * @return Vertex* zone mémoire alloué
  */
-Vertex* allocCellVertex(Point *p) {
-    Vertex *cell = (Vertex*)malloc(sizeof(Vertex));
-    if (!cell) {
-        return cell;
+Vertex* allocCellVertex(ReserveVertex *r, Point p) {
+    COMPTE(COMPTEUR_VERTEX);
+    Vertex *cell = r->libres;
+    if (cell) {
+        r->libres = cell->suiv;
+    } else {
+        if ((!r->blocs || r->blocs->nbDistribues == r->blocs->taille) && !ajouteBlocVertex(r)) {
+            return NULL;
+        }
+        cell = &(r->blocs->cellules[r->blocs->nbDistribues]);
+        r->blocs->nbDistribues++;
     }
     cell->p = p;
     cell->suiv = NULL;
@@ -93,12 +491,13 @@ Vertex* allocCellVertex(Point *p) {
  * @brief Ajoute un vertex de point **p** en tant que premier point du polygone **Poly**
  * 
  * @param poly Polygône modifié
+ * @param r Réserve dans laquelle le Vertex est pris
  * @param p Point ajouté
  * @return int 1 : l'allocation d'un Vertex a réussi \n
  *             0 : l'allocation d'un Vertex a échoué 
  */
-int ajouteVertexPolygone(Polygone *poly, Point *p) {
-    Vertex* cell = allocCellVertex(p);
+int ajouteVertexPolygone(Polygone *poly, ReserveVertex *r, Point p) {
+    Vertex* cell = allocCellVertex(r, p);
     if (!cell) {
         printf("\nEchec de l'allocation de mémoire pour un Vertex\n");
         return 0;
@@ -126,8 +525,9 @@ int ajouteVertexPolygone(Polygone *poly, Point *p) {
  * 
  * @param v Vertex à libérer
  * @param poly Polygône contenant le Vertex
+ * @param r Réserve d'où provient le Vertex
  */
-void freeVertex(Vertex *v, Polygone *poly) {
+void freeVertex(Vertex *v, Polygone *poly, ReserveVertex *r) {
     if (v == *poly) {
         (*poly) = (*poly)->suiv;
     }
@@ -138,18 +538,18 @@ void freeVertex(Vertex *v, Polygone *poly) {
 
     (v->prec)->suiv = v->suiv;
     (v->suiv)->prec = v->prec;
-    free(v);
+    rendVertex(r, v);
 }
 
 /**
- * @brief Libére l'espace alloué par un polygone
+ * @brief Libére l'espace alloué par un polygone en rendant d'un coup tous les blocs de sa réserve
  * 
  * @param Poly 
+ * @param r Réserve d'où proviennent tous les Vertex du polygone et uniquement de ce polygone
  */
-void freePolygone(Polygone *Poly) {
-    while (*Poly) {
-        freeVertex(*Poly, Poly);
-    }
+void freePolygone(Polygone *Poly, ReserveVertex *r) {
+    libereReserveVertex(r);
+    *Poly = NULL;
 }
 
 /**
@@ -163,293 +563,2756 @@ void printPolygone(Polygone poly) {
     }
 
     Vertex* tete = poly;
-    printf("%f %f\n", poly->p->x, poly->p->y);
+    printf("%f %f\n", poly->p.x, poly->p.y);
     poly = poly->suiv;
     for (; poly != tete; poly = poly->suiv) {
-        printf("%f %f\n", poly->p->x, poly->p->y);
+        printf("%f %f\n", poly->p.x, poly->p.y);
     }
 }
 
-// ----------------Fonctions de gestion d'un ensemble de points----------------
+// ---------------Fonctions de gestion des Polygones en tableau----------------
 
 /**
- * @brief Initialise un ensemble à partir d'un tableau de points
+ * @brief Initialise et renvoie un polygone en tableau vide
  * 
- * @param tabPoints tableau des points
- * @param lenTabPoints longueur max du tableau tabPoints
- * @return Ensemble ensemble initialisé
+ * @return PolygoneTab Polygone initialisé
  */
-Ensemble initEnsemble(Point* tabPoints, int lenTabPoints) {
-    Ensemble e;
-    e.tabPoints = tabPoints;
-    e.nbPoints = 0;
-    e.maxLen = lenTabPoints;
-    return e;
+PolygoneTab initPolygoneTab(void) {
+    PolygoneTab poly;
+    poly.sommets = NULL;
+    poly.debut = 0;
+    poly.len = 0;
+    poly.maxLen = 0;
+    return poly;
 }
 
 /**
- * @brief Réallour la mémoire pour un tableau de point pour ajouter **bloc** places
+ * @brief Renvoie l'adresse du sommet d'indice **k** de **poly**, les indices sont pris modulo le nombre de sommets
  * 
- * @param tabPoints Tableau à réallouer
- * @return int 0 : Echec de la réallocation \n
- *             1 : Réussit de la réallocation
+ * @param poly Polygone non vide
+ * @param k Indice du sommet, 0 pour le premier sommet
+ * @return Point* Adresse du sommet dans le tableau circulaire
  */
-int reAllocTabPoint(Ensemble *e) {
-    e->tabPoints = (Point*)realloc(e->tabPoints, sizeof(Point) * (e->maxLen +  BLOC));
-    if (e->tabPoints) {
-        e->maxLen += BLOC;
-        return 1;
+Point* sommetPolygoneTab(PolygoneTab *poly, int k) {
+    k %= (poly->len ? poly->len : 1);
+    if (k < 0) {
+        k += poly->len;
     }
-    free(e->tabPoints);
-    return 0;
+    k += poly->debut;
+    if (k >= poly->maxLen) {
+        k -= poly->maxLen;
+    }
+    return &(poly->sommets[k]);
 }
 
 /**
- * @brief Ajoute un point **p** à un ensemble **e**
+ * @brief Double la taille du tableau de **poly**, les sommets sont recopiés à partir du début du nouveau tableau
  * 
- * @param e ensemble à modifier
- * @param p point à ajouter
+ * @param poly Polygône à agrandir
+ * @return int 1 : l'allocation a réussi \n
+ *             0 : l'allocation a échoué, le polygône est inchangé
+ */
+int agranditPolygoneTab(PolygoneTab *poly) {
+    int taille = poly->maxLen ? 2 * poly->maxLen : BLOC;
+    Point *sommets = (Point*)malloc(sizeof(Point) * taille);
+    if (!sommets) {
+        return 0;
+    }
+    for (int k = 0; k < poly->len; ++k) {
+        sommets[k] = *sommetPolygoneTab(poly, k);
+    }
+    free(poly->sommets);
+    poly->sommets = sommets;
+    poly->debut = 0;
+    poly->maxLen = taille;
+    return 1;
+}
+
+/**
+ * @brief Ajoute le point **p** en tant que premier sommet du polygone **poly**, 
+ * équivalent de ajouteVertexPolygone en O(1) amorti
  * 
- * @return int 0 : Echec de la réallocation \n
- *             1 : Réussit de la réallocation
+ * @param poly Polygône modifié
+ * @param p Point ajouté
+ * @return int 1 : l'ajout a réussi \n
+ *             0 : l'agrandissement du tableau a échoué
  */
-int ajoutePointEnsemble(Ensemble *e, Point p) {
-    if (e->nbPoints == e->maxLen) {
-        if (!reAllocTabPoint(e)) {
-            return 0;
-        }
+int ajouteSommetPolygoneTab(PolygoneTab *poly, Point p) {
+    if (poly->len == poly->maxLen && !agranditPolygoneTab(poly)) {
+        printf("\nEchec de l'allocation de mémoire pour un PolygoneTab\n");
+        return 0;
     }
-    e->tabPoints[e->nbPoints] = p;
-    e->nbPoints++;
+    poly->debut = poly->debut ? poly->debut - 1 : poly->maxLen - 1;
+    poly->sommets[poly->debut] = p;
+    poly->len++;
     return 1;
 }
 
 /**
- * @brief Affiche les coordonnées des points de l'ensemble ainsi que ses informations
+ * @brief Enlève le sommet d'indice **k** du polygone **poly**, équivalent de freeVertex : 
+ * si le premier sommet est enlevé son suivant devient le premier \n
+ * Seule la plus courte des deux parties du tableau autour du sommet est décalée
  * 
- * @param e 
+ * @param poly Polygône modifié
+ * @param k Indice du sommet à enlever
  */
-void printEnsemble(Ensemble e) {
-    int k;
-    for (k = 0; k < e.nbPoints; ++k) {
-        printf("%f %f\n", e.tabPoints[k].x, e.tabPoints[k].y);
+void supprimeSommetPolygoneTab(PolygoneTab *poly, int k) {
+    int i;
+    k %= poly->len;
+    if (k < 0) {
+        k += poly->len;
     }
-    printf("longueur tableau : %d\n", e.nbPoints);
-    printf("longueur max tableau : %d\n", e.maxLen);
+
+    if (k < poly->len - 1 - k) {  // Décale les sommets précédents vers la fin
+        for (i = k; i > 0; --i) {
+            *sommetPolygoneTab(poly, i) = *sommetPolygoneTab(poly, i - 1);
+        }
+        poly->debut = (poly->debut + 1 == poly->maxLen) ? 0 : poly->debut + 1;
+    } else {  // Décale les sommets suivants vers le début
+        for (i = k; i < poly->len - 1; ++i) {
+            *sommetPolygoneTab(poly, i) = *sommetPolygoneTab(poly, i + 1);
+        }
+    }
+    poly->len--;
 }
 
-// ---------------------Fonctions de gestion des ConvexHull--------------------
+/**
+ * @brief Fait du sommet d'indice **k** le premier sommet de **poly**, équivalent de 
+ * l'affectation de la tête d'un Polygone \n
+ * Les sommets passent un par un de l'autre côté du trou, ce qui déplace le trou sans changer 
+ * l'ordre des sommets : au plus la moitié des sommets est recopiée
+ * 
+ * @param poly Polygône non vide
+ * @param k Indice du nouveau premier sommet
+ */
+void tournePolygoneTab(PolygoneTab *poly, int k) {
+    int i;
+    k %= poly->len;
+    if (k < 0) {
+        k += poly->len;
+    }
+
+    if (k <= poly->len - k) {  // Les k premiers sommets passent après le dernier
+        int fin = (poly->debut + poly->len) % poly->maxLen;  // Première place du trou
+        for (i = 0; i < k; ++i) {
+            poly->sommets[fin] = poly->sommets[poly->debut];
+            fin = (fin + 1 == poly->maxLen) ? 0 : fin + 1;
+            poly->debut = (poly->debut + 1 == poly->maxLen) ? 0 : poly->debut + 1;
+        }
+    } else {  // Les derniers sommets passent avant le premier
+        for (i = k; i < poly->len; ++i) {
+            Point dernier = *sommetPolygoneTab(poly, -1);
+            poly->debut = poly->debut ? poly->debut - 1 : poly->maxLen - 1;
+            poly->sommets[poly->debut] = dernier;
+        }
+    }
+}
 
 /**
- * @brief Initialise et renvoie une structure ConvexHull **c** avec des valeurs nulls
+ * @brief Libére l'espace alloué par un polygone en tableau
  * 
- * @return c Structure initialisé
+ * @param poly 
  */
-ConvexHull initConvexHull(void) {
-    ConvexHull c;
-    c.p = NULL;
-    c.avg = 0;
-    c.curlen = 0;
-    c.maxlen = 0;
-    c.nbMaj = 0;
-    return c;
+void freePolygoneTab(PolygoneTab *poly) {
+    free(poly->sommets);
+    *poly = initPolygoneTab();
 }
 
 /**
- * @brief Met à jour les données de **env_convex**
+ * @brief Affiche les coordonnées de chaque sommet d'un polygone en tableau **poly**
  * 
- * @param env_convex envoloppe à mettre à jour
+ * @param poly Polygone à afficher
  */
-void majConvexHull(ConvexHull* env_convex) {
-    // Détérmine si la longueur max a changé
-    if (env_convex->curlen > env_convex->maxlen) {
-        env_convex->maxlen = env_convex->curlen;
+void printPolygoneTab(PolygoneTab poly) {
+    for (int k = 0; k < poly.len; ++k) {
+        Point *s = sommetPolygoneTab(&poly, k);
+        printf("%f %f\n", s->x, s->y);
     }
-    // Recalcule de la moyenne
-    env_convex->avg = (env_convex->avg * env_convex->nbMaj + env_convex->curlen) / (env_convex->nbMaj + 1);
+}
 
-    env_convex->nbMaj++;
+// -----------------Fonctions de gestion des chaînes en arbre------------------
+
+/**
+ * @brief Mélange les bits de **x** (finaliseur de splitmix64) : deux entrées voisines donnent des sorties sans lien
+ * 
+ * @param x 
+ * @return uint64_t 
+ */
+uint64_t melange64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
 }
 
-// ----------------Algorithme d'ajout de points dans l'ensemble----------------
+/**
+ * @brief Initialise et renvoie une chaîne vide
+ * 
+ * @param superieure 1 : chaîne supérieure \n
+ *                   0 : chaîne inférieure
+ * @return Chaine Chaîne initialisée
+ */
+Chaine initChaine(int superieure) {
+    Chaine c;
+    c.racine = NULL;
+    c.len = 0;
+    c.superieure = superieure;
+    c.compteur = 0;
+    return c;
+}
 
 /**
- * @brief Détérmine si un triangle formé de **a** **b** et **c** est directe selon le sens trigonométrique
+ * @brief Fusionne deux arbres dont tous les points de **a** sont avant ceux de **b**
  * 
  * @param a 
  * @param b 
- * @param c 
- * @return int 1 : Le triangle est directe \n
- *             0 : Le triangle est indirecte
+ * @return NoeudChaine* Racine de l'arbre fusionné
  */
-int triangleDirecte(Point a, Point b, Point c) {
-    // Comme notre axe des ordonnées n'a pas la même orientation, on change le signe des ordonnées dans la formule
-    double scalaire = ((b.x - a.x) * ((-c.y) - (-a.y))) - ((c.x - a.x) * ((-b.y) - (-a.y)));
-    if (scalaire >= 0) {
-        return 1;
+NoeudChaine* fusionneArbresChaine(NoeudChaine *a, NoeudChaine *b) {
+    if (!a) {
+        return b;
     }
-    return 0;
+    if (!b) {
+        return a;
+    }
+    if (a->priorite > b->priorite) {
+        a->droite = fusionneArbresChaine(a->droite, b);
+        return a;
+    }
+    b->gauche = fusionneArbresChaine(a, b->gauche);
+    return b;
 }
 
 /**
- * @brief Regarde si le point p est dans l'enveloppe ou non et la modifie en concéquence
+ * @brief Coupe l'arbre **a** en deux : les points avant **p** dans **gauche**, les autres dans **droite**
  * 
- * @param env_convex Enveloppe à mettre à jour
- * @param p Point à vérifier
+ * @param a Arbre coupé
+ * @param p Point de coupe
+ * @param gauche Arbre des points avant **p**
+ * @param droite Arbre des points égaux ou après **p**
  */
-void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
-    // Si il y a moins de 2 points dans env_convex on ajoute p à l'enveloppe
-    if (env_convex->curlen < 2) {
-        if (!ajouteVertexPolygone(&(env_convex->p), p)) {
-            printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
-            exit(1);
-        }
-        env_convex->curlen++;
-        majConvexHull(env_convex);
+void coupeArbreChaine(NoeudChaine *a, Point p, NoeudChaine **gauche, NoeudChaine **droite) {
+    if (!a) {
+        *gauche = NULL;
+        *droite = NULL;
         return;
     }
+    if (ordrePoints(a->p, p) < 0) {
+        coupeArbreChaine(a->droite, p, &(a->droite), droite);
+        *gauche = a;
+    } else {
+        coupeArbreChaine(a->gauche, p, gauche, &(a->gauche));
+        *droite = a;
+    }
+}
 
-    // Orientation du premier triangle
-    if (env_convex->curlen == 2) {
+/**
+ * @brief Ajoute le sommet **p** dans la chaîne **c**, en O(log h)
+ * 
+ * @param c Chaîne modifiée, elle ne contient pas encore **p**
+ * @param p Sommet ajouté
+ * @return int 1 : l'allocation du noeud a réussi \n
+ *             0 : l'allocation du noeud a échoué
+ */
+int ajouteSommetChaine(Chaine *c, Point p) {
+    NoeudChaine *noeud = (NoeudChaine*)malloc(sizeof(NoeudChaine));
+    if (!noeud) {
+        return 0;
+    }
+    noeud->p = p;
+    c->compteur += 0x9E3779B97F4A7C15ULL;
+    noeud->priorite = melange64(c->compteur);
+    noeud->gauche = NULL;
+    noeud->droite = NULL;
+
+    NoeudChaine *gauche;
+    NoeudChaine *droite;
+    coupeArbreChaine(c->racine, p, &gauche, &droite);
+    c->racine = fusionneArbresChaine(fusionneArbresChaine(gauche, noeud), droite);
+    c->len++;
+    return 1;
+}
+
+/**
+ * @brief Enlève le sommet **p** de la chaîne **c**, en O(log h)
+ * 
+ * @param c Chaîne modifiée
+ * @param p Sommet enlevé, présent dans la chaîne
+ */
+void supprimeSommetChaine(Chaine *c, Point p) {
+    NoeudChaine **a = &(c->racine);
+    int ordre;
+    while (*a && (ordre = ordrePoints(p, (*a)->p))) {
+        a = (ordre < 0) ? &((*a)->gauche) : &((*a)->droite);
+    }
+    if (!*a) {
+        return;
+    }
+    NoeudChaine *tmp = *a;
+    *a = fusionneArbresChaine(tmp->gauche, tmp->droite);
+    free(tmp);
+    c->len--;
+}
+
+/**
+ * @brief Cherche le sommet de **c** qui précède ou suit directement **p** dans l'ordre lexicographique
+ * 
+ * @param c Chaîne parcourue
+ * @param p Point de référence, pas forcément dans la chaîne
+ * @param apres 0 : cherche le dernier sommet avant **p** \n
+ *              1 : cherche le premier sommet après **p**
+ * @return Point* Adresse du sommet trouvé, NULL si il n'existe pas
+ */
+Point* voisinChaine(Chaine *c, Point p, int apres) {
+    Point *voisin = NULL;
+    NoeudChaine *a = c->racine;
+    while (a) {
+        int ordre = ordrePoints(a->p, p);
+        if (apres ? (ordre > 0) : (ordre < 0)) {
+            voisin = &(a->p);
+            a = apres ? a->gauche : a->droite;
+        } else {
+            a = apres ? a->droite : a->gauche;
+        }
+    }
+    return voisin;
+}
+
+/**
+ * @brief Renvoie le sommet de la chaîne **c** confondu avec **p**
+ * 
+ * @param c Chaîne parcourue
+ * @param p Point cherché
+ * @return Point* Adresse du sommet, NULL si **p** n'est pas dans la chaîne
+ */
+Point* chercheChaine(Chaine *c, Point p) {
+    NoeudChaine *a = c->racine;
+    int ordre;
+    while (a && (ordre = ordrePoints(p, a->p))) {
+        a = (ordre < 0) ? a->gauche : a->droite;
+    }
+    return a ? &(a->p) : NULL;
+}
+
+/**
+ * @brief Renvoie le premier ou le dernier sommet de la chaîne **c**
+ * 
+ * @param c Chaîne parcourue
+ * @param derniere 0 : premier sommet (le plus à gauche) \n
+ *                 1 : dernier sommet (le plus à droite)
+ * @return Point* Adresse du sommet, NULL si la chaîne est vide
+ */
+Point* extremiteChaine(Chaine *c, int derniere) {
+    NoeudChaine *a = c->racine;
+    if (!a) {
+        return NULL;
+    }
+    while (derniere ? a->droite : a->gauche) {
+        a = derniere ? a->droite : a->gauche;
+    }
+    return &(a->p);
+}
+
+/**
+ * @brief Libére l'espace alloué par l'arbre **a**
+ * 
+ * @param a 
+ */
+void freeArbreChaine(NoeudChaine *a) {
+    if (!a) {
+        return;
+    }
+    freeArbreChaine(a->gauche);
+    freeArbreChaine(a->droite);
+    free(a);
+}
+
+/**
+ * @brief Libére l'espace alloué par une chaîne
+ * 
+ * @param c 
+ */
+void freeChaine(Chaine *c) {
+    freeArbreChaine(c->racine);
+    *c = initChaine(c->superieure);
+}
+
+/**
+ * @brief Ajoute au polygone **poly** les sommets de l'arbre **a** dans l'ordre lexicographique 
+ * ou dans l'ordre inverse, sans les points **debut** et **fin** des extrémités de la chaîne
+ * 
+ * @param a Arbre parcouru
+ * @param inverse 0 : ordre lexicographique, 1 : ordre inverse
+ * @param poly Polygone complété
+ * @param r Réserve du polygone
+ * @param debut Premier sommet à ne pas ajouter
+ * @param fin Dernier sommet à ne pas ajouter
+ * @return int 1 : les allocations ont réussi \n
+ *             0 : l'allocation d'un Vertex a échoué
+ */
+int ajouteArbreChainePolygone(NoeudChaine *a, int inverse, Polygone *poly, ReserveVertex *r, Point *debut, Point *fin) {
+    if (!a) {
+        return 1;
+    }
+    if (!ajouteArbreChainePolygone(inverse ? a->droite : a->gauche, inverse, poly, r, debut, fin)) {
+        return 0;
+    }
+    if (&(a->p) != debut && &(a->p) != fin && !ajouteVertexPolygone(poly, r, a->p)) {
+        return 0;
+    }
+    return ajouteArbreChainePolygone(inverse ? a->gauche : a->droite, inverse, poly, r, debut, fin);
+}
+
+// ----------------Fonctions de gestion d'un ensemble de points----------------
+
+/**
+ * @brief Initialise un ensemble à partir d'un tableau de points
+ * 
+ * @param tabPoints tableau des points
+ * @param lenTabPoints longueur max du tableau tabPoints
+ * @return Ensemble ensemble initialisé
+ */
+Ensemble initEnsemble(Point* tabPoints, int lenTabPoints) {
+    Ensemble e;
+    e.tabPoints = tabPoints;
+    e.nbPoints = 0;
+    e.maxLen = lenTabPoints;
+    return e;
+}
+
+/**
+ * @brief Réalloue le tableau de points de **e** pour qu'il contienne **taille** places \n
+ * En cas d'échec l'ancien tableau reste valide et inchangé
+ * 
+ * @param e Ensemble dont le tableau est réalloué
+ * @param taille Nouvelle taille du tableau, au moins égale à e->nbPoints
+ * @return int 0 : Echec de la réallocation \n
+ *             1 : Réussit de la réallocation
+ */
+int redimensionneTabPoint(Ensemble *e, int taille) {
+    Point *tabPoints = (Point*)realloc(e->tabPoints, sizeof(Point) * (size_t)taille);
+    if (!tabPoints) {
+        return 0;
+    }
+    e->tabPoints = tabPoints;
+    e->maxLen = taille;
+    return 1;
+}
+
+/**
+ * @brief Agrandit le tableau de points de **e** en doublant sa taille (au moins **BLOC** places) \n
+ * La croissance géométrique rend l'ajout d'un point en O(1) amorti
+ * 
+ * @param e Ensemble dont le tableau est réalloué
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
+int reAllocTabPoint(Ensemble *e) {
+    int taille = BLOC;
+    if (e->maxLen >= INT_MAX / 2) {
+        taille = INT_MAX;
+    } else if (e->maxLen >= BLOC) {
+        taille = 2 * e->maxLen;
+    }
+    if (taille <= e->maxLen) {
+        return 0;
+    }
+    return redimensionneTabPoint(e, taille);
+}
+
+/**
+ * @brief Réserve de la place pour au moins **taille** points dans **e**, 
+ * utile pour dimensionner le tableau une seule fois avant un ajout massif
+ * 
+ * @param e Ensemble à agrandir
+ * @param taille Nombre de places voulues
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
+int reserveEnsemble(Ensemble *e, int taille) {
+    if (taille <= e->maxLen) {
+        return 1;
+    }
+    return redimensionneTabPoint(e, taille);
+}
+
+/**
+ * @brief Réduit le tableau de points de **e** à son nombre de points pour libérer la place inutilisée
+ * 
+ * @param e Ensemble à ajuster
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
+int ajusteEnsemble(Ensemble *e) {
+    if (e->nbPoints == e->maxLen || !e->nbPoints) {
+        return 1;
+    }
+    return redimensionneTabPoint(e, e->nbPoints);
+}
+
+/**
+ * @brief Ajoute un point **p** à un ensemble **e**
+ * 
+ * @param e ensemble à modifier
+ * @param p point à ajouter
+ * 
+ * @return int 0 : Echec de la réallocation \n
+ *             1 : Réussit de la réallocation
+ */
+int ajoutePointEnsemble(Ensemble *e, Point p) {
+    if (e->nbPoints == e->maxLen) {
+        if (!reAllocTabPoint(e)) {
+            return 0;
+        }
+    }
+    e->tabPoints[e->nbPoints] = p;
+    e->nbPoints++;
+    return 1;
+}
+
+/**
+ * @brief Ajoute à l'ensemble **e** les points lus dans **f** (deux coordonnées par ligne)
+ * 
+ * @param f Fichier lu jusqu'à sa fin ou jusqu'à la première ligne mal formée
+ * @param e Ensemble à compléter
+ * @return int 0 : Echec de la réallocation \n
+ *             1 : Réussit de la lecture
+ */
+int lectureEnsemble(FILE *f, Ensemble *e) {
+    Point p;
+    while (fscanf(f, "%lf %lf", &p.x, &p.y) == 2) {
+        if (!ajoutePointEnsemble(e, p)) {
+            return 0;
+        }
+    }
+    if (!feof(f)) {
+        fprintf(stderr, "Lecture interrompue après %d points : ligne mal formée\n", e->nbPoints);
+    }
+    return 1;
+}
+
+/**
+ * @brief Affiche les coordonnées des points de l'ensemble ainsi que ses informations
+ * 
+ * @param e 
+ */
+void printEnsemble(Ensemble e) {
+    int k;
+    for (k = 0; k < e.nbPoints; ++k) {
+        printf("%f %f\n", e.tabPoints[k].x, e.tabPoints[k].y);
+    }
+    printf("longueur tableau : %d\n", e.nbPoints);
+    printf("longueur max tableau : %d\n", e.maxLen);
+}
+
+#ifdef COMPTEURS
+// -------------------------Compteurs d'instrumentation------------------------
+
+/**
+ * @brief Renvoie la classe d'histogramme de la valeur **v** : 0 pour 0, k pour une valeur de 2^(k-1) à 2^k - 1
+ * 
+ * @param v 
+ * @return int 
+ */
+int classeHistogramme(long v) {
+    int classe = 0;
+    while (v && classe < NB_CLASSES - 1) {
+        v >>= 1;
+        classe++;
+    }
+    return classe;
+}
+
+/**
+ * @brief Range les compteurs de la mise à jour numéro **nbMaj** dans leurs histogrammes et les remet à zéro
+ * 
+ * @param nbMaj 
+ */
+void enregistreCompteurs(int nbMaj) {
+    for (int k = 0; k < NB_COMPTEURS; ++k) {
+        Histogramme *h = &(histogrammes[k]);
+        h->classes[classeHistogramme(compteursMaj[k])]++;
+        h->total += compteursMaj[k];
+        if (compteursMaj[k] > h->max) {
+            h->max = compteursMaj[k];
+            h->majMax = nbMaj;
+        }
+        compteursMaj[k] = 0;
+    }
+}
+
+/**
+ * @brief Ecrit dans **f** les histogrammes des compteurs du thread appelant : pour chaque compteur le total, 
+ * la plus grande valeur avec la mise à jour qui l'a donnée, puis une ligne "min max nombre" par classe non vide
+ * 
+ * @param f 
+ */
+void exporteCompteurs(FILE *f) {
+    const char *noms[NB_COMPTEURS] = {"orientations", "visites", "nettoyage_avant", "nettoyage_arriere", "vertex", "malloc"};
+    for (int k = 0; k < NB_COMPTEURS; ++k) {
+        Histogramme *h = &(histogrammes[k]);
+        fprintf(f, "%s : total %ld, max %ld (mise à jour %d)\n", noms[k], h->total, h->max, h->majMax);
+        for (int c = 0; c < NB_CLASSES; ++c) {
+            if (h->classes[c]) {
+                long min = c ? 1L << (c - 1) : 0;
+                long max = c ? (1L << c) - 1 : 0;
+                fprintf(f, "    %ld %ld %ld\n", min, max, h->classes[c]);
+            }
+        }
+    }
+}
+#endif
+
+// ---------------------Fonctions de gestion des ConvexHull--------------------
+
+/**
+ * @brief Initialise et renvoie une structure ConvexHull **c** avec des valeurs nulls
+ * 
+ * @return c Structure initialisé
+ */
+ConvexHull initConvexHull(void) {
+    ConvexHull c;
+    c.p = NULL;
+    c.avg = 0;
+    c.curlen = 0;
+    c.maxlen = 0;
+    c.nbMaj = 0;
+    c.nbRejets = 0;
+    c.reserve = initReserveVertex();
+    c.tab = initPolygoneTab();
+    c.sup = initChaine(1);
+    c.inf = initChaine(0);
+    c.dyn = NULL;
+    c.zone.vide = 1;
+    return c;
+}
+
+/**
+ * @brief Met à jour les données de **env_convex**
+ * 
+ * @param env_convex envoloppe à mettre à jour
+ */
+void majConvexHull(ConvexHull* env_convex) {
+#ifdef COMPTEURS
+    enregistreCompteurs(env_convex->nbMaj);
+#endif
+    // Détérmine si la longueur max a changé
+    if (env_convex->curlen > env_convex->maxlen) {
+        env_convex->maxlen = env_convex->curlen;
+    }
+    // Recalcule de la moyenne
+    env_convex->avg = (env_convex->avg * env_convex->nbMaj + env_convex->curlen) / (env_convex->nbMaj + 1);
+
+    env_convex->nbMaj++;
+}
+
+/**
+ * @brief Affiche les informations de l'enveloppe **env_convex**
+ * 
+ * @param env_convex 
+ */
+void printInfoConvexHull(ConvexHull env_convex) {
+    printf("ENVELOPPE CONVEXE INFO :\n");
+    printf("    curlen = %d \n", env_convex.curlen);
+    printf("    maxlen = %d \n", env_convex.maxlen);
+    printf("    avg = %f \n", env_convex.avg);
+    printf("    nbMaj = %d \n", env_convex.nbMaj);
+    printf("    nbRejets = %d \n", env_convex.nbRejets);
+    printf("\n");
+}
+
+// ----------------Algorithme d'ajout de points dans l'ensemble----------------
+
+/**
+ * @brief Calcule **a** + **b** et l'erreur d'arrondi de cette somme, de sorte que 
+ * **somme** + **erreur** = **a** + **b** exactement
+ * 
+ * @param a 
+ * @param b 
+ * @param somme Somme arrondie
+ * @param erreur Erreur d'arrondi
+ */
+void sommeExacte(double a, double b, double *somme, double *erreur) {
+    double s = a + b;
+    double bVirtuel = s - a;
+    double aVirtuel = s - bVirtuel;
+    *erreur = (a - aVirtuel) + (b - bVirtuel);
+    *somme = s;
+}
+
+/**
+ * @brief Calcule **a** * **b** et l'erreur d'arrondi de ce produit, de sorte que 
+ * **produit** + **erreur** = **a** * **b** exactement
+ * 
+ * @param a 
+ * @param b 
+ * @param produit Produit arrondi
+ * @param erreur Erreur d'arrondi
+ */
+void produitExact(double a, double b, double *produit, double *erreur) {
+    *produit = a * b;
+    *erreur = fma(a, b, -*produit);
+}
+
+/**
+ * @brief Ajoute **b** à l'expansion **e** (somme de doubles sans chevauchement, par magnitude croissante), 
+ * les composantes nulles sont éliminées
+ * 
+ * @param e Expansion à agrandir, de taille au moins **len** + 1
+ * @param len Nombre de composantes de **e**
+ * @param b Double à ajouter
+ * @return int Nouveau nombre de composantes de **e**
+ */
+int ajouteExpansion(double *e, int len, double b) {
+    int nouvLen = 0;
+    double q = b;
+    for (int k = 0; k < len; ++k) {
+        double erreur;
+        sommeExacte(q, e[k], &q, &erreur);
+        if (erreur != 0) {
+            e[nouvLen++] = erreur;
+        }
+    }
+    if (q != 0) {
+        e[nouvLen++] = q;
+    }
+    return nouvLen;
+}
+
+/**
+ * @brief Calcule exactement le signe du déterminant d'orientation de **a** **b** **c**, 
+ * chacun des six produits est décomposé sans erreur et sommé dans une expansion
+ * 
+ * @param a 
+ * @param b 
+ * @param c 
+ * @return double Du signe de l'orientation dans un repère d'ordonnées vers le haut
+ */
+double orientationExacte(Point a, Point b, Point c) {
+    double termes[6][2] = {{a.x, b.y}, {-a.y, b.x}, {b.x, c.y}, {-b.y, c.x}, {c.x, a.y}, {-c.y, a.x}};
+    double e[12];
+    int len = 0;
+    for (int k = 0; k < 6; ++k) {
+        double produit, erreur;
+        produitExact(termes[k][0], termes[k][1], &produit, &erreur);
+        len = ajouteExpansion(e, len, erreur);
+        len = ajouteExpansion(e, len, produit);
+    }
+    // La composante de plus grande magnitude donne le signe de l'expansion
+    return len ? e[len - 1] : 0;
+}
+
+/**
+ * @brief Calcule le déterminant d'orientation de **a** **b** **c** avec un signe toujours exact : 
+ * le calcul flottant est gardé si sa borne d'erreur le permet, sinon on passe à orientationExacte
+ * 
+ * @param a 
+ * @param b 
+ * @param c 
+ * @return double > 0 : **a** **b** **c** tournent dans le sens trigonométrique (ordonnées vers le haut) \n
+ *                0 : **a** **b** **c** sont alignés \n
+ *              < 0 : **a** **b** **c** tournent dans le sens horaire
+ */
+double orientation(Point a, Point b, Point c) {
+    COMPTE(COMPTEUR_ORIENTATIONS);
+    double gauche = (a.x - c.x) * (b.y - c.y);
+    double droite = (a.y - c.y) * (b.x - c.x);
+    double det = gauche - droite;
+    double somme;
+
+    // Si les deux produits sont de signes opposés la soustraction ne peut pas changer le signe
+    if (gauche > 0) {
+        if (droite <= 0) {
+            return det;
+        }
+        somme = gauche + droite;
+    } else if (gauche < 0) {
+        if (droite >= 0) {
+            return det;
+        }
+        somme = -gauche - droite;
+    } else {
+        return det;
+    }
+
+    if (det >= ERREUR_ORIENTATION * somme || -det >= ERREUR_ORIENTATION * somme) {
+        return det;
+    }
+    return orientationExacte(a, b, c);
+}
+
+/**
+ * @brief Détérmine si un triangle formé de **a** **b** et **c** est directe selon le sens trigonométrique
+ * 
+ * @param a 
+ * @param b 
+ * @param c 
+ * @return int 1 : Le triangle est directe \n
+ *             0 : Le triangle est indirecte
+ */
+int triangleDirecte(Point a, Point b, Point c) {
+    // Comme notre axe des ordonnées n'a pas la même orientation, le sens trigonométrique à l'écran est le sens horaire de orientation
+    if (orientation(a, b, c) <= 0) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Traite l'ajout de **p** à une enveloppe réduite au segment [**a**, **b**] : si les trois points 
+ * sont alignés, l'extrémité dépassée par **p** est échangée avec **p**
+ * 
+ * @param a Première extrémité du segment
+ * @param b Seconde extrémité du segment
+ * @param p Point ajouté, contient en sortie le point qui n'est plus une extrémité
+ * @return int 1 : **p** est aligné avec **a** et **b**, le segment est à jour \n
+ *             0 : **p** n'est pas aligné, il forme un triangle avec **a** et **b**
+ */
+int prolongeSegment(Point *a, Point *b, Point *p) {
+    if (orientation(*a, *b, *p) != 0) {
+        return 0;
+    }
+    Point *min = (ordrePoints(*a, *b) <= 0) ? a : b;
+    Point *max = (min == a) ? b : a;
+    Point tmp = *p;
+    if (ordrePoints(*p, *min) < 0) {
+        *p = *min;
+        *min = tmp;
+    } else if (ordrePoints(*p, *max) > 0) {
+        *p = *max;
+        *max = tmp;
+    }
+    return 1;
+}
+
+/**
+ * @brief Met à jour les huit points extrêmes **extremes** avec le point **p**
+ * 
+ * @param extremes Tableau de huit points extrêmes déjà initialisé
+ * @param p Point ajouté
+ */
+void majExtremes(Point *extremes, Point p) {
+    // Directions dans l'ordre trigonométrique
+    static const int dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static const int dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    for (int k = 0; k < 8; ++k) {
+        if (dx[k] * p.x + dy[k] * p.y > dx[k] * extremes[k].x + dy[k] * extremes[k].y) {
+            extremes[k] = p;
+        }
+    }
+}
+
+/**
+ * @brief Met à jour les points extrêmes de **env_convex** dans les 8 directions multiples de 45° avec le point **p** \n
+ * Le premier point de l'enveloppe est extrême dans toutes les directions
+ * 
+ * @param env_convex Enveloppe à mettre à jour
+ * @param p Point ajouté à l'enveloppe
+ */
+void majExtremesConvexHull(ConvexHull *env_convex, Point p) {
+    if (!env_convex->nbMaj) {
+        for (int k = 0; k < 8; ++k) {
+            env_convex->extremes[k] = p;
+        }
+        return;
+    }
+    majExtremes(env_convex->extremes, p);
+}
+
+/**
+ * @brief Détermine si **p** est strictement à l'intérieur de l'octogone des points extrêmes de 
+ * **env_convex**, les points extrêmes étant dans l'enveloppe **p** l'est aussi (filtre d'Akl-Toussaint)
+ * 
+ * @param env_convex Enveloppe contenant au moins un point
+ * @param p Point à vérifier
+ * @return int 1 : **p** est strictement dans l'octogone \n
+ *             0 : **p** est sur le bord ou à l'extérieur de l'octogone
+ */
+int dansOctogoneConvexHull(ConvexHull *env_convex, Point p) {
+    Point *e = env_convex->extremes;
+    int nbCotes = 0;
+    for (int k = 0; k < 8; ++k) {
+        Point *suiv = &(e[(k + 1) % 8]);
+        if (e[k].x == suiv->x && e[k].y == suiv->y) {
+            continue;
+        }
+        // L'octogone est parcouru dans le sens inverse d'un polygône direct
+        if (triangleDirecte(e[k], *suiv, p)) {
+            return 0;
+        }
+        nbCotes++;
+    }
+    return nbCotes > 0;
+}
+
+/**
+ * @brief Agrandit la zone **z** pour qu'elle contienne le point **p**
+ * 
+ * @param z 
+ * @param p 
+ */
+void etendZone(ZoneModifiee *z, Point p) {
+    if (z->vide) {
+        z->min = p;
+        z->max = p;
+        z->vide = 0;
+        return;
+    }
+    z->min.x = fmin(z->min.x, p.x);
+    z->min.y = fmin(z->min.y, p.y);
+    z->max.x = fmax(z->max.x, p.x);
+    z->max.y = fmax(z->max.y, p.y);
+}
+
+/**
+ * @brief Agrandit la zone **z** pour qu'elle contienne la zone **ajout**
+ * 
+ * @param z 
+ * @param ajout 
+ */
+void fusionneZone(ZoneModifiee *z, ZoneModifiee ajout) {
+    if (!ajout.vide) {
+        etendZone(z, ajout.min);
+        etendZone(z, ajout.max);
+    }
+}
+
+/**
+ * @brief Regarde si le point p est dans l'enveloppe ou non et la modifie en concéquence
+ * 
+ * @param env_convex Enveloppe à mettre à jour
+ * @param p Point à vérifier, copié dans l'enveloppe s'il en devient un sommet
+ */
+void majEnveloppeConvex(ConvexHull *env_convex, Point p) {
+    // La zone modifiée contient au moins le nouveau point de l'ensemble
+    env_convex->zone.vide = 1;
+    etendZone(&(env_convex->zone), p);
+
+    // Un point dans l'octogone des points extrêmes est dans l'enveloppe, inutile de parcourir le polygône
+    if (env_convex->curlen >= 3 && dansOctogoneConvexHull(env_convex, p)) {
+        env_convex->nbRejets++;
+        majConvexHull(env_convex);
+        return;
+    }
+    majExtremesConvexHull(env_convex, p);
+
+    // Un point confondu avec l'unique sommet ne change rien
+    if (env_convex->curlen == 1 && ordrePoints(p, env_convex->p->p) == 0) {
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Tant que l'enveloppe est un segment, un point aligné ne fait qu'en déplacer une extrémité
+    if (env_convex->curlen == 2 && prolongeSegment(&(env_convex->p->p), &(env_convex->p->suiv->p), &p)) {
+        etendZone(&(env_convex->zone), env_convex->p->p);
+        etendZone(&(env_convex->zone), env_convex->p->suiv->p);
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Si il y a moins de 2 points dans env_convex on ajoute p à l'enveloppe
+    if (env_convex->curlen < 2) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
+            printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            exit(1);
+        }
+        etendZone(&(env_convex->zone), env_convex->p->suiv->p);
+        env_convex->curlen++;
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Orientation du premier triangle
+    if (env_convex->curlen == 2) {
         // Si les trois premiers points forment un triangle indirecte, on reforme la liste pour avoir un direct
-        if (!ajouteVertexPolygone(&(env_convex->p), p)) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
+            printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            exit(1);
+        }
+        if (!triangleDirecte(env_convex->p->p, env_convex->p->suiv->p, env_convex->p->prec->p)) {
+            Point tmp = env_convex->p->suiv->p;
+            env_convex->p->suiv->p = env_convex->p->prec->p;
+            env_convex->p->prec->p = tmp;
+        }
+        etendZone(&(env_convex->zone), env_convex->p->suiv->p);
+        etendZone(&(env_convex->zone), env_convex->p->prec->p);
+        env_convex->curlen++;
+        majConvexHull(env_convex);
+        return;
+    }
+
+    Vertex *s_i = env_convex->p;
+    Vertex *s_j = s_i->suiv;
+    do {
+        COMPTE(COMPTEUR_VISITES);
+        s_i = s_j;
+        s_j = s_j->suiv;
+    } while (triangleDirecte(p, s_i->p, s_j->p) && s_i != env_convex->p);  // Tant que le triangle est directe est qu'on a pas vérifier tous les points
+
+    // Si on est sortit de la boucle car tous les triangles sont directes, on arrête là
+    if (triangleDirecte(p, s_i->p, s_j->p) && s_i == env_convex->p) {
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // si on à un triangle indirecte
+    // On insére p en tant que nouvelle tête de liste
+    env_convex->p = s_j;
+    if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+    env_convex->curlen++;
+    
+    // Nettoyage avant
+    s_i = env_convex->p->suiv;
+    s_j = s_i->suiv;
+    while (!triangleDirecte(env_convex->p->p, s_i->p, s_j->p)) {
+        COMPTE(COMPTEUR_NETTOYAGE_AVANT);
+        etendZone(&(env_convex->zone), s_i->p);
+        freeVertex(s_i, &(env_convex->p), &(env_convex->reserve));
+        s_i = env_convex->p->suiv;
+        s_j = s_i->suiv;
+        env_convex->curlen--;
+    }
+
+    // Nettoyage arrière
+    s_i = env_convex->p->prec->prec;
+    s_j = env_convex->p->prec;
+    while (!triangleDirecte(env_convex->p->p, s_i->p, s_j->p)) {
+        COMPTE(COMPTEUR_NETTOYAGE_ARRIERE);
+        etendZone(&(env_convex->zone), s_j->p);
+        freeVertex(s_j, &(env_convex->p), &(env_convex->reserve));
+        s_i = env_convex->p->prec->prec;
+        s_j = env_convex->p->prec;
+        env_convex->curlen--;
+    }
+
+    // Les anciens côtés entre les voisins de p sont dans la zone des sommets enlevés et des nouveaux côtés
+    etendZone(&(env_convex->zone), env_convex->p->suiv->p);
+    etendZone(&(env_convex->zone), env_convex->p->prec->p);
+    majConvexHull(env_convex);
+}
+
+/**
+ * @brief Même algorithme que majEnveloppeConvex sur l'enveloppe rangée dans le tableau 
+ * circulaire env_convex->tab : la recherche parcourt une zone contiguë de la mémoire, 
+ * l'insertion recopie au plus la moitié des sommets et chaque nettoyage se fait en O(1)
+ * 
+ * @param env_convex Enveloppe à mettre à jour
+ * @param p Point à vérifier, copié dans l'enveloppe s'il en devient un sommet
+ */
+void majEnveloppeConvexTab(ConvexHull *env_convex, Point p) {
+    PolygoneTab *poly = &(env_convex->tab);
+
+    // Un point dans l'octogone des points extrêmes est dans l'enveloppe, inutile de parcourir le tableau
+    if (env_convex->curlen >= 3 && dansOctogoneConvexHull(env_convex, p)) {
+        env_convex->nbRejets++;
+        majConvexHull(env_convex);
+        return;
+    }
+    majExtremesConvexHull(env_convex, p);
+
+    // Un point confondu avec l'unique sommet ne change rien
+    if (env_convex->curlen == 1 && ordrePoints(p, *sommetPolygoneTab(poly, 0)) == 0) {
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Tant que l'enveloppe est un segment, un point aligné ne fait qu'en déplacer une extrémité
+    if (env_convex->curlen == 2 && prolongeSegment(sommetPolygoneTab(poly, 0), sommetPolygoneTab(poly, 1), &p)) {
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Si il y a moins de 3 points dans env_convex on ajoute p à l'enveloppe
+    if (env_convex->curlen < 3) {
+        if (!ajouteSommetPolygoneTab(poly, p)) {
             printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
             exit(1);
         }
-        if (!triangleDirecte(*(env_convex->p->p), *(env_convex->p->suiv->p), *(env_convex->p->prec->p))) {
-            Point *tmp = env_convex->p->suiv->p;
-            env_convex->p->suiv->p = env_convex->p->prec->p;
-            env_convex->p->prec->p = tmp;
+        // Si les trois premiers points forment un triangle indirecte, on échange les deux derniers
+        if (poly->len == 3 && !triangleDirecte(*sommetPolygoneTab(poly, 0), *sommetPolygoneTab(poly, 1), *sommetPolygoneTab(poly, 2))) {
+            Point tmp = *sommetPolygoneTab(poly, 1);
+            *sommetPolygoneTab(poly, 1) = *sommetPolygoneTab(poly, 2);
+            *sommetPolygoneTab(poly, 2) = tmp;
+        }
+        env_convex->curlen++;
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // Parcours du tableau à partir du deuxième sommet, i et j sont les positions de s_i et s_j dans le tableau
+    Point *s = poly->sommets;
+    int dernier = (int)(sommetPolygoneTab(poly, -1) - s);
+    int i = poly->debut;
+    int j = (i == dernier) ? poly->debut : ((i + 1 == poly->maxLen) ? 0 : i + 1);
+    int k = 0;  // Indice de s_i dans le polygône
+    do {
+        i = j;
+        j = (j == dernier) ? poly->debut : ((j + 1 == poly->maxLen) ? 0 : j + 1);
+        k++;
+    } while (triangleDirecte(p, s[i], s[j]) && k < poly->len);  // Tant que le triangle est directe est qu'on a pas vérifier tous les points
+
+    // Si on est sortit de la boucle car tous les triangles sont directes, on arrête là
+    if (k == poly->len && triangleDirecte(p, s[i], s[j])) {
+        majConvexHull(env_convex);
+        return;
+    }
+
+    // On insére p en tant que premier sommet, juste avant s_j
+    tournePolygoneTab(poly, k + 1);
+    if (!ajouteSommetPolygoneTab(poly, p)) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+    env_convex->curlen++;
+
+    // Nettoyage avant, enlever le sommet d'indice 1 ne décale que p
+    while (!triangleDirecte(p, *sommetPolygoneTab(poly, 1), *sommetPolygoneTab(poly, 2))) {
+        supprimeSommetPolygoneTab(poly, 1);
+        env_convex->curlen--;
+    }
+
+    // Nettoyage arrière, enlever le dernier sommet ne décale rien
+    while (!triangleDirecte(p, *sommetPolygoneTab(poly, -2), *sommetPolygoneTab(poly, -1))) {
+        supprimeSommetPolygoneTab(poly, -1);
+        env_convex->curlen--;
+    }
+    majConvexHull(env_convex);
+}
+
+// ------------------Classement vectoriel de points par blocs------------------
+
+/**
+ * @brief Range les sommets distincts de l'octogone **extremes** dans **sommets** en les 
+ * parcourant dans le sens d'un polygône direct (l'inverse de l'ordre des extremes)
+ * 
+ * @param extremes Les huit points extrêmes d'un ensemble
+ * @param sommets Tableau d'au moins huit points à remplir
+ * @return int Nombre de sommets rangés
+ */
+int octogoneDirect(const Point *extremes, Point *sommets) {
+    int nbSommets = 0;
+    for (int k = 7; k >= 0; --k) {
+        if (nbSommets == 0 || extremes[k].x != sommets[nbSommets - 1].x || extremes[k].y != sommets[nbSommets - 1].y) {
+            sommets[nbSommets++] = extremes[k];
+        }
+    }
+    if (nbSommets > 1 && sommets[0].x == sommets[nbSommets - 1].x && sommets[0].y == sommets[nbSommets - 1].y) {
+        nbSommets--;
+    }
+    return nbSommets;
+}
+
+/**
+ * @brief Teste tous les points de **bloc** contre chacun des côtés du polygône convexe direct 
+ * **sommets** : le bit k du résultat vaut 1 si le k-ième point n'est pas strictement à gauche 
+ * d'au moins un côté (au sens de triangleDirecte), c'est à dire s'il n'est pas strictement dans 
+ * le polygône. Les points dont le bit vaut 0 peuvent être écartés sans autre test. \n
+ * Le test est prudent : un point dont l'orientation est dans la borne d'erreur d'arrondi est gardé \n
+ * Les côtés de longueur nulle sont ignorés, un octogone réduit à un sommet garde tous les points \n
+ * Les points sont traités par 4 (AVX2) ou 2 (SSE2) à la fois
+ * 
+ * @param bloc Points à classer
+ * @param sommets Sommets d'un polygône convexe direct
+ * @param nbSommets Nombre de sommets
+ * @return uint64_t Masque des points à l'extérieur ou sur le bord du polygône
+ */
+uint64_t masqueExterieur(const BlocPoints *bloc, const Point *sommets, int nbSommets) {
+    // Tous les points confondus : l'octogone n'a aucun côté et n'écarte aucun point
+    if (nbSommets < 2) {
+        return UINT64_MAX;
+    }
+    uint64_t masque = 0;
+    int k = 0;
+
+#if defined(__AVX2__)
+    const __m256d signe = _mm256_set1_pd(-0.0);  // Masque du bit de signe, pour les valeurs absolues
+    for (; k + 4 <= bloc->nbPoints; k += 4) {
+        __m256d px = _mm256_loadu_pd(&(bloc->x[k]));
+        __m256d py = _mm256_loadu_pd(&(bloc->y[k]));
+        __m256d dehors = _mm256_setzero_pd();
+        for (int i = 0; i < nbSommets; ++i) {
+            const Point *a = &(sommets[i]);
+            const Point *b = &(sommets[(i + 1) % nbSommets]);
+            if (a->x == b->x && a->y == b->y) {
+                continue;
+            }
+            __m256d ex = _mm256_set1_pd(b->x - a->x);
+            __m256d ey = _mm256_set1_pd(b->y - a->y);
+            __m256d dx = _mm256_sub_pd(px, _mm256_set1_pd(a->x));
+            __m256d dy = _mm256_sub_pd(py, _mm256_set1_pd(a->y));
+            __m256d gauche = _mm256_mul_pd(ex, dy);
+            __m256d droite = _mm256_mul_pd(ey, dx);
+            __m256d orient = _mm256_sub_pd(gauche, droite);
+            __m256d somme = _mm256_add_pd(_mm256_andnot_pd(signe, gauche), _mm256_andnot_pd(signe, droite));
+            __m256d borne = _mm256_mul_pd(_mm256_set1_pd(-ERREUR_ORIENTATION), somme);
+            dehors = _mm256_or_pd(dehors, _mm256_cmp_pd(orient, borne, _CMP_GE_OQ));
+        }
+        masque |= (uint64_t)_mm256_movemask_pd(dehors) << k;
+    }
+#elif defined(__SSE2__)
+    const __m128d signe = _mm_set1_pd(-0.0);  // Masque du bit de signe, pour les valeurs absolues
+    for (; k + 2 <= bloc->nbPoints; k += 2) {
+        __m128d px = _mm_loadu_pd(&(bloc->x[k]));
+        __m128d py = _mm_loadu_pd(&(bloc->y[k]));
+        __m128d dehors = _mm_setzero_pd();
+        for (int i = 0; i < nbSommets; ++i) {
+            const Point *a = &(sommets[i]);
+            const Point *b = &(sommets[(i + 1) % nbSommets]);
+            if (a->x == b->x && a->y == b->y) {
+                continue;
+            }
+            __m128d ex = _mm_set1_pd(b->x - a->x);
+            __m128d ey = _mm_set1_pd(b->y - a->y);
+            __m128d dx = _mm_sub_pd(px, _mm_set1_pd(a->x));
+            __m128d dy = _mm_sub_pd(py, _mm_set1_pd(a->y));
+            __m128d gauche = _mm_mul_pd(ex, dy);
+            __m128d droite = _mm_mul_pd(ey, dx);
+            __m128d orient = _mm_sub_pd(gauche, droite);
+            __m128d somme = _mm_add_pd(_mm_andnot_pd(signe, gauche), _mm_andnot_pd(signe, droite));
+            __m128d borne = _mm_mul_pd(_mm_set1_pd(-ERREUR_ORIENTATION), somme);
+            dehors = _mm_or_pd(dehors, _mm_cmpge_pd(orient, borne));
+        }
+        masque |= (uint64_t)_mm_movemask_pd(dehors) << k;
+    }
+#endif
+
+    // Points restants, ou tous les points sans jeu d'instructions vectoriel
+    for (; k < bloc->nbPoints; ++k) {
+        for (int i = 0; i < nbSommets; ++i) {
+            const Point *a = &(sommets[i]);
+            const Point *b = &(sommets[(i + 1) % nbSommets]);
+            if (a->x == b->x && a->y == b->y) {
+                continue;
+            }
+            double gauche = (b->x - a->x) * (bloc->y[k] - a->y);
+            double droite = (b->y - a->y) * (bloc->x[k] - a->x);
+            if (gauche - droite >= -ERREUR_ORIENTATION * (fabs(gauche) + fabs(droite))) {
+                masque |= (uint64_t)1 << k;
+                break;
+            }
+        }
+    }
+    return masque;
+}
+
+// -----------Algorithme de calcul de l'enveloppe en une seule fois------------
+
+/**
+ * @brief Compare deux adresses de points selon l'ordre lexicographique (x puis y), utilisé par qsort
+ *
+ * @param a Adresse d'un Point*
+ * @param b Adresse d'un Point*
+ * @return int < 0 : **a** est avant **b** \n
+ *             0 : **a** et **b** sont confondus \n
+ *             > 0 : **a** est après **b**
+ */
+int comparePoints(const void *a, const void *b) {
+    return ordrePoints(**(Point * const *)a, **(Point * const *)b);
+}
+
+/**
+ * @brief Calcule en une seule fois l'enveloppe convexe de tous les points de **e**
+ * avec la chaîne monotone d'Andrew (O(n log n)) et remplace le contenu de **env_convex**
+ *
+ * @param env_convex Enveloppe remplacée, le polygône est orienté comme avec majEnveloppeConvex
+ * @param e Ensemble de points dont on calcule l'enveloppe
+ * @return int 1 : Le calcul a réussi \n
+ *             0 : Echec d'une allocation de mémoire
+ */
+int enveloppeConvexeEnsemble(ConvexHull *env_convex, Ensemble e) {
+    int k;
+    int n = e.nbPoints;
+
+    freePolygone(&(env_convex->p), &(env_convex->reserve));
+    *env_convex = initConvexHull();
+    if (n == 0) {
+        return 1;
+    }
+
+    Point **tri = (Point**)malloc(sizeof(Point*) * n);
+    Point **chaine = (Point**)malloc(sizeof(Point*) * 2 * n);  // Sommets de l'enveloppe dans l'ordre de parcours
+    BlocPoints *bloc = (BlocPoints*)malloc(sizeof(BlocPoints));
+    if (!tri || !chaine || !bloc) {
+        free(tri);
+        free(chaine);
+        free(bloc);
+        return 0;
+    }
+
+    // Filtre d'Akl-Toussaint : seuls les points qui ne sont pas strictement dans l'octogone sont triés
+    for (k = 0; k < 8; ++k) {
+        env_convex->extremes[k] = e.tabPoints[0];
+    }
+    for (k = 1; k < n; ++k) {
+        majExtremes(env_convex->extremes, e.tabPoints[k]);
+    }
+    Point octogone[8];
+    int nbSommets = octogoneDirect(env_convex->extremes, octogone);
+    int nbCandidats = 0;
+    for (int debut = 0; debut < n; debut += BLOC_POINTS) {
+        bloc->nbPoints = n - debut < BLOC_POINTS ? n - debut : BLOC_POINTS;
+        for (k = 0; k < bloc->nbPoints; ++k) {
+            bloc->x[k] = e.tabPoints[debut + k].x;
+            bloc->y[k] = e.tabPoints[debut + k].y;
+        }
+        uint64_t masque = masqueExterieur(bloc, octogone, nbSommets);
+        for (k = 0; k < bloc->nbPoints; ++k) {
+            if (masque >> k & 1) {
+                tri[nbCandidats++] = &(e.tabPoints[debut + k]);
+            }
+        }
+    }
+    free(bloc);
+    env_convex->nbRejets = n - nbCandidats;
+    n = nbCandidats;
+    qsort(tri, n, sizeof(Point*), comparePoints);
+
+    // Les points confondus ne forment qu'un sommet
+    int nbDistincts = 0;
+    for (k = 0; k < n; ++k) {
+        if (nbDistincts == 0 || ordrePoints(*tri[nbDistincts - 1], *tri[k])) {
+            tri[nbDistincts++] = tri[k];
+        }
+    }
+    n = nbDistincts;
+
+    int lenChaine = 0;
+    if (n < 3) {
+        for (k = 0; k < n; ++k) {
+            chaine[lenChaine++] = tri[k];
+        }
+    } else {
+        // Chaîne inférieure, on retire le dernier sommet tant qu'il ne forme pas un virage strict
+        for (k = 0; k < n; ++k) {
+            while (lenChaine >= 2 && triangleDirecte(*chaine[lenChaine - 2], *chaine[lenChaine - 1], *tri[k])) {
+                lenChaine--;
+            }
+            chaine[lenChaine++] = tri[k];
+        }
+        // Chaîne supérieure, le dernier point ajouté est le premier de la chaîne inférieure
+        int debutSup = lenChaine + 1;
+        for (k = n - 2; k >= 0; --k) {
+            while (lenChaine >= debutSup && triangleDirecte(*chaine[lenChaine - 2], *chaine[lenChaine - 1], *tri[k])) {
+                lenChaine--;
+            }
+            chaine[lenChaine++] = tri[k];
+        }
+        lenChaine--;
+    }
+
+    // ajouteVertexPolygone insère en tête, la chaîne est donc parcourue dans le sens direct une fois insérée
+    for (k = 0; k < lenChaine; ++k) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), *chaine[k])) {
+            freePolygone(&(env_convex->p), &(env_convex->reserve));
+            free(tri);
+            free(chaine);
+            return 0;
+        }
+    }
+    env_convex->curlen = lenChaine;
+    majConvexHull(env_convex);
+
+    free(tri);
+    free(chaine);
+    return 1;
+}
+
+// -------------Algorithme de calcul de l'enveloppe en parallèle--------------
+
+/**
+ * @brief Renvoie le nombre de coeurs disponibles, au moins 1
+ * 
+ * @return int Nombre de coeurs
+ */
+int nombreCoeurs(void) {
+    long nb = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb < 1) {
+        return 1;
+    }
+    return (nb > INT_MAX) ? INT_MAX : (int)nb;
+}
+
+/**
+ * @brief Fonction d'un thread du calcul parallèle : calcule l'enveloppe de sa tranche 
+ * avec enveloppeConvexeEnsemble, chaque thread n'écrit que dans son propre travail
+ * 
+ * @param arg Adresse d'un TravailEnveloppe
+ * @return void* NULL
+ */
+void* threadEnveloppe(void *arg) {
+    TravailEnveloppe *travail = (TravailEnveloppe*)arg;
+    travail->reussite = enveloppeConvexeEnsemble(&(travail->env_convex), travail->e);
+    return NULL;
+}
+
+/**
+ * @brief Calcule l'enveloppe convexe de tous les points de **e** en découpant l'ensemble en 
+ * **nbThreads** tranches : chaque thread calcule l'enveloppe de sa tranche, puis l'enveloppe 
+ * des sommets de toutes les enveloppes partielles est calculée par le thread appelant \n
+ * Les enveloppes partielles ont peu de sommets, la fusion est négligeable devant le calcul des tranches \n
+ * Une tranche contient au moins **POINTS_PAR_THREAD** points, avec peu de points le calcul se fait sur un seul thread
+ *
+ * @param env_convex Enveloppe remplacée, le polygône est orienté comme avec majEnveloppeConvex
+ * @param e Ensemble de points dont on calcule l'enveloppe
+ * @param nbThreads Nombre maximal de threads de calcul
+ * @return int 1 : Le calcul a réussi \n
+ *             0 : Echec d'une allocation de mémoire ou de la création d'un thread
+ */
+int enveloppeConvexeParallele(ConvexHull *env_convex, Ensemble e, int nbThreads) {
+    int k;
+    if (nbThreads > e.nbPoints / POINTS_PAR_THREAD) {
+        nbThreads = e.nbPoints / POINTS_PAR_THREAD;
+    }
+    if (nbThreads <= 1) {
+        return enveloppeConvexeEnsemble(env_convex, e);
+    }
+
+    TravailEnveloppe *travaux = (TravailEnveloppe*)malloc(sizeof(TravailEnveloppe) * nbThreads);
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * nbThreads);
+    if (!travaux || !threads) {
+        free(travaux);
+        free(threads);
+        return 0;
+    }
+
+    // Tranches contiguës de tailles égales à un point près, la dernière est traitée par le thread appelant
+    int reussite = 1;
+    int nbLances = 0;
+    for (k = 0; k < nbThreads; ++k) {
+        int debut = (int)((long long)e.nbPoints * k / nbThreads);
+        int fin = (int)((long long)e.nbPoints * (k + 1) / nbThreads);
+        travaux[k].e = initEnsemble(e.tabPoints + debut, fin - debut);
+        travaux[k].e.nbPoints = fin - debut;
+        travaux[k].env_convex = initConvexHull();
+        travaux[k].reussite = 0;
+    }
+    for (k = 0; k < nbThreads - 1; ++k) {
+        if (pthread_create(&(threads[k]), NULL, threadEnveloppe, &(travaux[k]))) {
+            reussite = 0;
+            break;
+        }
+        nbLances++;
+    }
+    if (reussite) {
+        threadEnveloppe(&(travaux[nbThreads - 1]));
+    }
+    for (k = 0; k < nbLances; ++k) {
+        pthread_join(threads[k], NULL);
+    }
+
+    // Fusion : l'enveloppe des sommets des enveloppes partielles est celle de tout l'ensemble
+    Ensemble sommets = initEnsemble(NULL, 0);
+    int nbRejets = 0;
+    for (k = 0; k < nbThreads && reussite; ++k) {
+        reussite = travaux[k].reussite && reserveEnsemble(&sommets, sommets.nbPoints + travaux[k].env_convex.curlen);
+        Vertex *v = travaux[k].env_convex.p;
+        for (int i = 0; reussite && i < travaux[k].env_convex.curlen; ++i, v = v->suiv) {
+            ajoutePointEnsemble(&sommets, v->p);
+        }
+        nbRejets += travaux[k].env_convex.nbRejets;
+    }
+    if (reussite) {
+        reussite = enveloppeConvexeEnsemble(env_convex, sommets);
+        env_convex->nbRejets += nbRejets;
+    }
+
+    for (k = 0; k < nbThreads; ++k) {
+        freePolygone(&(travaux[k].env_convex.p), &(travaux[k].env_convex.reserve));
+    }
+    free(sommets.tabPoints);
+    free(travaux);
+    free(threads);
+    return reussite;
+}
+
+// -----------Algorithme d'ajout de points dans des chaînes en arbre-----------
+
+/**
+ * @brief Détermine si le sommet **b** est inutile dans la chaîne **c** entre ses voisins **a** et **d**, 
+ * c'est à dire si il n'est pas strictement au dessus (chaîne supérieure) ou en dessous (chaîne inférieure) du segment [a, d]
+ * 
+ * @param c Chaîne contenant **b**
+ * @param a Voisin avant **b**
+ * @param b 
+ * @param d Voisin après **b**
+ * @return int 1 : **b** est inutile \n
+ *             0 : **b** est un sommet de la chaîne
+ */
+int sommetInutileChaine(Chaine *c, Point a, Point b, Point d) {
+    if (c->superieure) {
+        return triangleDirecte(d, b, a);
+    }
+    return triangleDirecte(a, b, d);
+}
+
+/**
+ * @brief Ajoute **p** à la chaîne **c** si il n'est pas sous la chaîne supérieure (au dessus de la 
+ * chaîne inférieure) et enlève les sommets devenus inutiles \n
+ * Les voisins de **p** sont trouvés par recherche dans l'arbre en O(log h), chaque sommet enlevé coûte O(log h)
+ * 
+ * @param c Chaîne à mettre à jour
+ * @param p Point ajouté
+ * @return int 1 : **p** est un nouveau sommet de la chaîne \n
+ *             0 : **p** n'est pas un sommet de la chaîne
+ */
+int majChaine(Chaine *c, Point p) {
+    if (chercheChaine(c, p)) {
+        return 0;
+    }
+    Point *prec = voisinChaine(c, p, 0);
+    Point *suiv = voisinChaine(c, p, 1);
+    if (prec && suiv && sommetInutileChaine(c, *prec, p, *suiv)) {
+        return 0;
+    }
+
+    if (!ajouteSommetChaine(c, p)) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+
+    // Nettoyage avant
+    Point *suiv2;
+    while (suiv && (suiv2 = voisinChaine(c, *suiv, 1)) && sommetInutileChaine(c, p, *suiv, *suiv2)) {
+        supprimeSommetChaine(c, *suiv);  // Les autres noeuds ne sont pas déplacés en mémoire
+        suiv = suiv2;
+    }
+
+    // Nettoyage arrière
+    Point *prec2;
+    while (prec && (prec2 = voisinChaine(c, *prec, 0)) && sommetInutileChaine(c, *prec2, *prec, p)) {
+        supprimeSommetChaine(c, *prec);
+        prec = prec2;
+    }
+    return 1;
+}
+
+/**
+ * @brief Regarde si le point p est dans l'enveloppe ou non et la modifie en concéquence \n
+ * L'enveloppe est rangée dans deux arbres équilibrés (chaînes supérieure et inférieure) 
+ * ce qui rend l'ajout en O(log h) plus O(log h) par sommet enlevé
+ * 
+ * @param env_convex Enveloppe à mettre à jour, utilise les champs sup et inf
+ * @param p Point à vérifier
+ */
+void majEnveloppeConvexArbre(ConvexHull *env_convex, Point p) {
+    majChaine(&(env_convex->sup), p);
+    majChaine(&(env_convex->inf), p);
+
+    // Les deux chaînes partagent leurs extrémités, qui sont confondues si il n'y a qu'un point distinct
+    env_convex->curlen = env_convex->sup.len + env_convex->inf.len - 2;
+    if (env_convex->sup.len == 1) {
+        env_convex->curlen = 1;
+    }
+    majConvexHull(env_convex);
+}
+
+/**
+ * @brief Remplace le polygône de **env_convex** par les sommets de ses chaînes en arbre, 
+ * orienté comme avec majEnveloppeConvex
+ * 
+ * @param env_convex Enveloppe dont les chaînes sont recopiées
+ * @return int 1 : les allocations ont réussi \n
+ *             0 : l'allocation d'un Vertex a échoué
+ */
+int enveloppeArbreVersPolygone(ConvexHull *env_convex) {
+    freePolygone(&(env_convex->p), &(env_convex->reserve));
+    env_convex->reserve = initReserveVertex();
+    if (!env_convex->inf.len) {
+        return 1;
+    }
+
+    // Chaîne inférieure de gauche à droite puis chaîne supérieure de droite à gauche sans ses extrémités
+    if (!ajouteArbreChainePolygone(env_convex->inf.racine, 0, &(env_convex->p), &(env_convex->reserve), NULL, NULL)) {
+        return 0;
+    }
+    return ajouteArbreChainePolygone(env_convex->sup.racine, 1, &(env_convex->p), &(env_convex->reserve), 
+                                     extremiteChaine(&(env_convex->sup), 0), extremiteChaine(&(env_convex->sup), 1));
+}
+
+// -------------Algorithme d'enveloppe avec ajouts et suppressions-------------
+
+/**
+ * @brief Alloue un noeud de l'arbre dynamique et arrête le programme si la mémoire manque
+ * 
+ * @return NoeudDynamique* Noeud alloué, ses champs ne sont pas initialisés
+ */
+NoeudDynamique* allocNoeudDynamique(void) {
+    NoeudDynamique *n = (NoeudDynamique*)malloc(sizeof(NoeudDynamique));
+    if (!n) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+    return n;
+}
+
+/**
+ * @brief Renvoie l'orientation de **c** par rapport à la droite (**a**, **b**) vue depuis l'extérieur de la chaîne **s**
+ * 
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param a 
+ * @param b Point après **a** dans l'ordre lexicographique
+ * @param c 
+ * @return double Positif si **c** est au dessus de (**a**, **b**) pour la chaîne supérieure, 
+ *                en dessous pour la chaîne inférieure, nul si les trois points sont alignés
+ */
+double orientationChaine(int s, Point a, Point b, Point c) {
+    double o = orientation(a, b, c);
+    return s ? o : -o;
+}
+
+/**
+ * @brief Compte les sommets de la chaîne **s** du sous arbre **n** placés avant **p** ou après **p**, 
+ * **p** compris, en O(log n) grâce aux longueurs gardées à chaque pont
+ * 
+ * @param n Sous arbre parcouru
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param p Sommet de la chaîne de **n**
+ * @param apres 0 : compte les sommets jusqu'à **p** \n
+ *              1 : compte les sommets à partir de **p**
+ * @return int Nombre de sommets
+ */
+int comptePortionChaine(NoeudDynamique *n, int s, Point p, int apres) {
+    if (!n->gauche) {
+        return 1;
+    }
+    int len = n->lenGauche[s] + n->lenDroite[s];
+    if (!apres) {
+        if (ordrePoints(p, n->pont[s][1]) < 0) {
+            return comptePortionChaine(n->gauche, s, p, 0);
+        }
+        return len + 1 - comptePortionChaine(n->droite, s, p, 1);
+    }
+    if (ordrePoints(p, n->pont[s][0]) > 0) {
+        return comptePortionChaine(n->droite, s, p, 1);
+    }
+    return len + 1 - comptePortionChaine(n->gauche, s, p, 0);
+}
+
+/**
+ * @brief Descend dans **n** jusqu'au premier noeud dont le pont de la chaîne **s** est entre **debut** et **fin** : 
+ * ce noeud contient la partie de la chaîne de **n** comprise entre ces deux sommets
+ * 
+ * @param n Sous arbre parcouru
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param debut Premier sommet gardé de la chaîne de **n**, NULL si il n'y a pas de limite
+ * @param fin Dernier sommet gardé de la chaîne de **n**, NULL si il n'y a pas de limite
+ * @return NoeudDynamique* Noeud atteint
+ */
+NoeudDynamique* restreintChaineDynamique(NoeudDynamique *n, int s, Point *debut, Point *fin) {
+    while (n->gauche) {
+        if (fin && ordrePoints(*fin, n->pont[s][1]) < 0) {
+            n = n->gauche;
+        } else if (debut && ordrePoints(*debut, n->pont[s][0]) > 0) {
+            n = n->droite;
+        } else {
+            break;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Calcule le pont de la chaîne **s** du noeud **n** à partir des chaînes de ses deux fils \n
+ * Les deux chaînes sont descendues en même temps (Overmars et van Leeuwen) : à chaque étape le pont d'un fils 
+ * permet d'écarter la moitié d'une des deux chaînes, ce qui donne le pont en O(log n) \n
+ * Les sommets alignés sont écartés, le pont relie les points les plus éloignés
+ * 
+ * @param n Noeud interne dont les fils sont à jour
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ */
+void calculePontDynamique(NoeudDynamique *n, int s) {
+    NoeudDynamique *a = n->gauche;
+    NoeudDynamique *b = n->droite;
+    Point *debutA = NULL, *finA = NULL, *debutB = NULL, *finB = NULL;  // Portions des chaînes où se trouve le pont
+    Point separation = {(a->max.x + b->min.x) / 2, (a->max.y + b->min.y) / 2};
+
+    while (1) {
+        a = restreintChaineDynamique(a, s, debutA, finA);
+        b = restreintChaineDynamique(b, s, debutB, finB);
+        if (!a->gauche && !b->gauche) {
+            break;
+        }
+        // Côté de chaque chaîne autour de son pont, réduit au point lui même pour une feuille
+        Point a1 = a->gauche ? a->pont[s][0] : a->p;
+        Point a2 = a->gauche ? a->pont[s][1] : a->p;
+        Point b1 = b->gauche ? b->pont[s][0] : b->p;
+        Point b2 = b->gauche ? b->pont[s][1] : b->p;
+
+        if (a->gauche && orientationChaine(s, a1, a2, b1) >= 0) {
+            // b1 voit le côté (a1, a2) : le pont de la chaîne de a est au plus a1
+            finA = &(a->pont[s][0]);
+            a = a->gauche;
+        } else if (b->gauche && orientationChaine(s, b1, b2, a2) >= 0) {
+            // a2 voit le côté (b1, b2) : le pont de la chaîne de b est au moins b2
+            debutB = &(b->pont[s][1]);
+            b = b->droite;
+        } else if (!a->gauche) {
+            finB = &(b->pont[s][0]);
+            b = b->gauche;
+        } else if (!b->gauche) {
+            debutA = &(a->pont[s][1]);
+            a = a->droite;
+        } else {
+            // Les droites (a1, a2) et (b1, b2) se croisent en i : le côté de la séparation où se trouve i 
+            // donne la chaîne dont la moitié peut être écartée
+            double s1 = orientationChaine(s, a1, a2, b1);
+            double s2 = orientationChaine(s, a1, a2, b2);
+            Point i = {(s1 * b2.x - s2 * b1.x) / (s1 - s2), (s1 * b2.y - s2 * b1.y) / (s1 - s2)};
+            if (ordrePoints(i, separation) < 0) {
+                debutA = &(a->pont[s][1]);
+                a = a->droite;
+            } else {
+                finB = &(b->pont[s][0]);
+                b = b->gauche;
+            }
+        }
+    }
+    n->pont[s][0] = a->p;
+    n->pont[s][1] = b->p;
+    n->lenGauche[s] = comptePortionChaine(n->gauche, s, a->p, 0);
+    n->lenDroite[s] = comptePortionChaine(n->droite, s, b->p, 1);
+}
+
+/**
+ * @brief Met à jour la taille et les points extrêmes du noeud interne **n** à partir de ses fils
+ * 
+ * @param n 
+ */
+void majTailleDynamique(NoeudDynamique *n) {
+    n->taille = n->gauche->taille + n->droite->taille;
+    n->min = n->gauche->min;
+    n->max = n->droite->max;
+}
+
+/**
+ * @brief Met à jour toutes les données du noeud interne **n** à partir de ses fils, en O(log² n)
+ * 
+ * @param n 
+ */
+void majNoeudDynamique(NoeudDynamique *n) {
+    majTailleDynamique(n);
+    calculePontDynamique(n, 0);
+    calculePontDynamique(n, 1);
+}
+
+/**
+ * @brief Détermine si un des fils du noeud interne **n** a plus des trois quarts de ses feuilles
+ * 
+ * @param n 
+ * @return int 1 : **n** doit être reconstruit \n
+ *             0 : **n** est équilibré
+ */
+int desequilibreDynamique(NoeudDynamique *n) {
+    return 4 * n->gauche->taille > 3 * n->taille || 4 * n->droite->taille > 3 * n->taille;
+}
+
+/**
+ * @brief Range les feuilles de **n** dans **feuilles** dans l'ordre et chaîne ses noeuds internes dans **libres**
+ * 
+ * @param n Sous arbre démonté
+ * @param feuilles Tableau complété
+ * @param nbFeuilles Nombre de feuilles déjà rangées
+ * @param libres Noeuds internes, chaînés par leur champ gauche
+ * @return int Nombre de feuilles rangées
+ */
+int demonteArbreDynamique(NoeudDynamique *n, NoeudDynamique **feuilles, int nbFeuilles, NoeudDynamique **libres) {
+    if (!n->gauche) {
+        feuilles[nbFeuilles] = n;
+        return nbFeuilles + 1;
+    }
+    nbFeuilles = demonteArbreDynamique(n->gauche, feuilles, nbFeuilles, libres);
+    nbFeuilles = demonteArbreDynamique(n->droite, feuilles, nbFeuilles, libres);
+    n->gauche = *libres;
+    *libres = n;
+    return nbFeuilles;
+}
+
+/**
+ * @brief Construit un arbre parfaitement équilibré sur les **nbFeuilles** feuilles rangées dans **feuilles**
+ * 
+ * @param feuilles 
+ * @param nbFeuilles 
+ * @param libres Noeuds internes réutilisés, il y en a au moins **nbFeuilles** - 1
+ * @return NoeudDynamique* Racine de l'arbre
+ */
+NoeudDynamique* construitArbreDynamique(NoeudDynamique **feuilles, int nbFeuilles, NoeudDynamique **libres) {
+    if (nbFeuilles == 1) {
+        return feuilles[0];
+    }
+    NoeudDynamique *n = *libres;
+    *libres = n->gauche;
+    n->gauche = construitArbreDynamique(feuilles, nbFeuilles / 2, libres);
+    n->droite = construitArbreDynamique(feuilles + nbFeuilles / 2, nbFeuilles - nbFeuilles / 2, libres);
+    majNoeudDynamique(n);
+    return n;
+}
+
+/**
+ * @brief Reconstruit le sous arbre **n** parfaitement équilibré en réutilisant ses noeuds, en O(k log k) 
+ * pour k feuilles
+ * 
+ * @param n 
+ * @return NoeudDynamique* Nouvelle racine du sous arbre
+ */
+NoeudDynamique* reconstruitArbreDynamique(NoeudDynamique *n) {
+    NoeudDynamique **feuilles = (NoeudDynamique**)malloc(n->taille * sizeof(NoeudDynamique*));
+    if (!feuilles) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+    NoeudDynamique *libres = NULL;
+    int nbFeuilles = demonteArbreDynamique(n, feuilles, 0, &libres);
+    n = construitArbreDynamique(feuilles, nbFeuilles, &libres);
+    free(feuilles);
+    return n;
+}
+
+/**
+ * @brief Renvoie l'adresse du pointeur vers le noeud **chemin**[k] : la racine ou un champ de son père
+ * 
+ * @param racine 
+ * @param chemin Noeuds traversés depuis la racine
+ * @param k 
+ * @return NoeudDynamique** 
+ */
+NoeudDynamique** lienNoeudDynamique(NoeudDynamique **racine, NoeudDynamique **chemin, int k) {
+    if (!k) {
+        return racine;
+    }
+    return (chemin[k - 1]->gauche == chemin[k]) ? &(chemin[k - 1]->gauche) : &(chemin[k - 1]->droite);
+}
+
+/**
+ * @brief Détermine si **p**, sommet de la chaîne **s** du fils de **n** qui le contient, est aussi un sommet 
+ * de la chaîne de **n**
+ * 
+ * @param n Noeud interne
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param p Feuille de **n**
+ * @return int 1 : **p** est gardé par le pont de **n** \n
+ *             0 : **p** est caché par le pont de **n**
+ */
+int gardeSommetDynamique(NoeudDynamique *n, int s, Point p) {
+    if (ordrePoints(p, n->gauche->max) <= 0) {
+        return ordrePoints(p, n->pont[s][0]) <= 0;
+    }
+    return ordrePoints(p, n->pont[s][1]) >= 0;
+}
+
+/**
+ * @brief Détermine si la feuille **p** du sous arbre **n** est un sommet de sa chaîne **s**
+ * 
+ * @param n 
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param p Feuille de **n**
+ * @return int 1 : **p** est un sommet de la chaîne \n
+ *             0 : **p** n'est pas un sommet de la chaîne
+ */
+int sommetChaineDynamique(NoeudDynamique *n, int s, Point p) {
+    while (n->gauche) {
+        if (!gardeSommetDynamique(n, s, p)) {
+            return 0;
+        }
+        n = (ordrePoints(p, n->gauche->max) <= 0) ? n->gauche : n->droite;
+    }
+    return 1;
+}
+
+/**
+ * @brief Remet à jour les noeuds de **chemin** après l'ajout ou la suppression de **p** sous le dernier d'entre eux \n
+ * Le plus haut noeud déséquilibré est reconstruit (reconstruction partielle), ce qui garde une profondeur 
+ * en O(log n) pour un coût amorti de O(log² n) par opération \n
+ * La chaîne d'un noeud ne change que si **p** en est un sommet : les ponts des noeuds plus haut ne sont pas recalculés
+ * 
+ * @param racine 
+ * @param chemin Noeuds internes traversés depuis la racine
+ * @param profondeur Nombre de noeuds de **chemin**
+ * @param p Point ajouté ou enlevé
+ * @param premier Pour une suppression, premier[s] est l'indice dans **chemin** du plus haut noeud dont **p** 
+ *                était un sommet de la chaîne s, NULL pour un ajout
+ */
+void reequilibreArbreDynamique(NoeudDynamique **racine, NoeudDynamique **chemin, int profondeur, Point p, int *premier) {
+    for (int k = profondeur - 1; k >= 0; --k) {
+        majTailleDynamique(chemin[k]);
+    }
+    int actif[2] = {1, 1};  // Ajout : p est un sommet de la chaîne du noeud en dessous
+    for (int k = 0; k < profondeur; ++k) {
+        if (desequilibreDynamique(chemin[k])) {
+            NoeudDynamique **lien = lienNoeudDynamique(racine, chemin, k);
+            *lien = reconstruitArbreDynamique(chemin[k]);
+            actif[0] = sommetChaineDynamique(*lien, 0, p);
+            actif[1] = sommetChaineDynamique(*lien, 1, p);
+            profondeur = k;
+            break;
+        }
+    }
+    // Les ponts sont recalculés du bas vers le haut, ceux du sous arbre reconstruit le sont déjà
+    for (int k = profondeur - 1; k >= 0; --k) {
+        for (int s = 0; s < 2; ++s) {
+            if (premier ? k >= premier[s] : actif[s]) {
+                calculePontDynamique(chemin[k], s);
+                actif[s] = gardeSommetDynamique(chemin[k], s, p);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Cherche la feuille où se trouve ou devrait se trouver **p** et range les noeuds internes traversés dans **chemin**
+ * 
+ * @param racine 
+ * @param p Point cherché
+ * @param chemin Noeuds internes traversés
+ * @param profondeur Nombre de noeuds de **chemin**
+ * @return NoeudDynamique** Adresse du pointeur vers la feuille, qui vaut NULL si l'arbre est vide
+ */
+NoeudDynamique** chercheFeuilleDynamique(NoeudDynamique **racine, Point p, NoeudDynamique **chemin, int *profondeur) {
+    NoeudDynamique **lien = racine;
+    *profondeur = 0;
+    while (*lien && (*lien)->gauche) {
+        chemin[(*profondeur)++] = *lien;
+        lien = (ordrePoints(p, (*lien)->gauche->max) <= 0) ? &((*lien)->gauche) : &((*lien)->droite);
+    }
+    return lien;
+}
+
+/**
+ * @brief Ajoute le point **p** à l'arbre **racine**, en O(log² n) amorti
+ * 
+ * @param racine 
+ * @param p 
+ */
+void ajoutePointDynamique(NoeudDynamique **racine, Point p) {
+    NoeudDynamique *chemin[PROFONDEUR_MAX];
+    int profondeur;
+    NoeudDynamique **lien = chercheFeuilleDynamique(racine, p, chemin, &profondeur);
+    if (*lien && !ordrePoints(p, (*lien)->p)) {
+        (*lien)->multiplicite++;
+        return;
+    }
+
+    NoeudDynamique *feuille = allocNoeudDynamique();
+    feuille->p = p;
+    feuille->multiplicite = 1;
+    feuille->taille = 1;
+    feuille->min = p;
+    feuille->max = p;
+    feuille->gauche = NULL;
+    feuille->droite = NULL;
+    if (!*lien) {
+        *lien = feuille;
+        return;
+    }
+
+    // La feuille trouvée est remplacée par un noeud interne dont elle est un fils
+    NoeudDynamique *n = allocNoeudDynamique();
+    n->gauche = (ordrePoints(p, (*lien)->p) < 0) ? feuille : *lien;
+    n->droite = (n->gauche == feuille) ? *lien : feuille;
+    majNoeudDynamique(n);
+    *lien = n;
+    reequilibreArbreDynamique(racine, chemin, profondeur, p, NULL);
+}
+
+/**
+ * @brief Enlève une copie du point **p** de l'arbre **racine**, en O(log² n) amorti
+ * 
+ * @param racine 
+ * @param p 
+ * @return int 1 : **p** a été enlevé \n
+ *             0 : **p** n'est pas dans l'arbre
+ */
+int supprimePointDynamique(NoeudDynamique **racine, Point p) {
+    NoeudDynamique *chemin[PROFONDEUR_MAX];
+    int profondeur;
+    NoeudDynamique **lien = chercheFeuilleDynamique(racine, p, chemin, &profondeur);
+    if (!*lien || ordrePoints(p, (*lien)->p)) {
+        return 0;
+    }
+    if ((*lien)->multiplicite > 1) {
+        (*lien)->multiplicite--;
+        return 1;
+    }
+
+    // La feuille n'est libérée qu'une fois les ponts qui la lisent encore parcourus
+    NoeudDynamique *feuille = *lien;
+    if (!profondeur) {
+        free(feuille);
+        *racine = NULL;
+        return 1;
+    }
+    // Noeuds dont p était un sommet, avec les ponts d'avant la suppression
+    int premier[2];
+    for (int s = 0; s < 2; ++s) {
+        premier[s] = profondeur;
+        while (premier[s] > 0 && gardeSommetDynamique(chemin[premier[s] - 1], s, p)) {
+            premier[s]--;
+        }
+    }
+
+    // Le frère de la feuille prend la place de leur père
+    NoeudDynamique *pere = chemin[profondeur - 1];
+    NoeudDynamique *frere = (&(pere->gauche) == lien) ? pere->droite : pere->gauche;
+    profondeur--;
+    *lienNoeudDynamique(racine, chemin, profondeur) = frere;
+    free(feuille);
+    free(pere);
+    reequilibreArbreDynamique(racine, chemin, profondeur, p, premier);
+    return 1;
+}
+
+/**
+ * @brief Libére l'espace alloué par l'arbre dynamique **n**
+ * 
+ * @param n 
+ */
+void freeArbreDynamique(NoeudDynamique *n) {
+    if (!n) {
+        return;
+    }
+    freeArbreDynamique(n->gauche);
+    freeArbreDynamique(n->droite);
+    free(n);
+}
+
+/**
+ * @brief Met à jour le nombre de sommets de **env_convex** à partir des chaînes de la racine de son arbre
+ * 
+ * @param env_convex 
+ */
+void majLenDynamique(ConvexHull *env_convex) {
+    NoeudDynamique *n = env_convex->dyn;
+    if (!n) {
+        env_convex->curlen = 0;
+    } else if (!n->gauche) {
+        env_convex->curlen = 1;
+    } else {
+        // Les deux chaînes partagent leurs extrémités
+        env_convex->curlen = n->lenGauche[0] + n->lenDroite[0] + n->lenGauche[1] + n->lenDroite[1] - 2;
+    }
+    majConvexHull(env_convex);
+}
+
+/**
+ * @brief Ajoute le point **p** à l'enveloppe **env_convex**, qui garde tous ses points pour pouvoir en enlever \n
+ * Les chaînes supérieure et inférieure ne sont pas recopiées, elles sont lues dans les ponts de l'arbre
+ * 
+ * @param env_convex Enveloppe à mettre à jour, utilise le champ dyn
+ * @param p Point ajouté
+ */
+void majEnveloppeConvexDynamique(ConvexHull *env_convex, Point p) {
+    ajoutePointDynamique(&(env_convex->dyn), p);
+    majLenDynamique(env_convex);
+}
+
+/**
+ * @brief Enlève le point **p** de l'enveloppe **env_convex**, les points intérieurs qu'il cachait 
+ * reviennent sur l'enveloppe
+ * 
+ * @param env_convex Enveloppe à mettre à jour, utilise le champ dyn
+ * @param p Point enlevé
+ * @return int 1 : **p** a été enlevé \n
+ *             0 : **p** n'a jamais été ajouté à l'enveloppe
+ */
+int supprimeEnveloppeConvexDynamique(ConvexHull *env_convex, Point p) {
+    if (!supprimePointDynamique(&(env_convex->dyn), p)) {
+        return 0;
+    }
+    majLenDynamique(env_convex);
+    return 1;
+}
+
+/**
+ * @brief Ajoute au polygone **poly** les sommets de la chaîne **s** de **n** compris entre **debut** et **fin**, 
+ * dans l'ordre lexicographique ou dans l'ordre inverse, sans les points **exclus1** et **exclus2**
+ * 
+ * @param n Sous arbre parcouru
+ * @param s 0 : chaîne inférieure, 1 : chaîne supérieure
+ * @param debut Premier sommet de la chaîne de **n** gardé, NULL si il n'y a pas de limite
+ * @param fin Dernier sommet de la chaîne de **n** gardé, NULL si il n'y a pas de limite
+ * @param inverse 0 : ordre lexicographique, 1 : ordre inverse
+ * @param env_convex Enveloppe dont le polygone et la réserve sont complétés
+ * @param exclus Extrémités de la chaîne à ne pas ajouter, NULL pour toutes les ajouter
+ * @return int 1 : les allocations ont réussi \n
+ *             0 : l'allocation d'un Vertex a échoué
+ */
+int ajouteChaineDynamiquePolygone(NoeudDynamique *n, int s, Point *debut, Point *fin, int inverse, ConvexHull *env_convex, Point *exclus) {
+    n = restreintChaineDynamique(n, s, debut, fin);
+    if (!n->gauche) {
+        if (exclus && (!ordrePoints(n->p, exclus[0]) || !ordrePoints(n->p, exclus[1]))) {
+            return 1;
+        }
+        return ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), n->p);
+    }
+    // Chaîne du fils gauche jusqu'au pont puis chaîne du fils droit à partir du pont
+    if (inverse) {
+        return ajouteChaineDynamiquePolygone(n->droite, s, &(n->pont[s][1]), fin, 1, env_convex, exclus)
+            && ajouteChaineDynamiquePolygone(n->gauche, s, debut, &(n->pont[s][0]), 1, env_convex, exclus);
+    }
+    return ajouteChaineDynamiquePolygone(n->gauche, s, debut, &(n->pont[s][0]), 0, env_convex, exclus)
+        && ajouteChaineDynamiquePolygone(n->droite, s, &(n->pont[s][1]), fin, 0, env_convex, exclus);
+}
+
+/**
+ * @brief Remplace le polygône de **env_convex** par les sommets lus dans son arbre dynamique, 
+ * orienté comme avec majEnveloppeConvex
+ * 
+ * @param env_convex Enveloppe dont les chaînes sont recopiées
+ * @return int 1 : les allocations ont réussi \n
+ *             0 : l'allocation d'un Vertex a échoué
+ */
+int enveloppeDynamiqueVersPolygone(ConvexHull *env_convex) {
+    freePolygone(&(env_convex->p), &(env_convex->reserve));
+    env_convex->reserve = initReserveVertex();
+    NoeudDynamique *racine = env_convex->dyn;
+    if (!racine) {
+        return 1;
+    }
+
+    // Chaîne inférieure de gauche à droite puis chaîne supérieure de droite à gauche sans ses extrémités
+    Point extremites[2] = {racine->min, racine->max};
+    if (!ajouteChaineDynamiquePolygone(racine, 0, NULL, NULL, 0, env_convex, NULL)) {
+        return 0;
+    }
+    return ajouteChaineDynamiquePolygone(racine, 1, NULL, NULL, 1, env_convex, extremites);
+}
+
+// -------------------Enveloppe d'une fenêtre glissante--------------------
+
+/**
+ * @brief Initialise et renvoie une fenêtre glissante vide
+ * 
+ * @param maxPoints Nombre maximal de points gardés, 0 : pas de limite
+ * @param duree Âge maximal des points gardés, 0 : pas de limite
+ * @return FenetrePoints Fenêtre initialisée
+ */
+FenetrePoints initFenetrePoints(int maxPoints, double duree) {
+    FenetrePoints f;
+    f.points = NULL;
+    f.debut = 0;
+    f.len = 0;
+    f.maxLen = 0;
+    f.maxPoints = maxPoints;
+    f.duree = duree;
+    return f;
+}
+
+/**
+ * @brief Double la taille du tableau de **f**, les points sont recopiés à partir du début du nouveau tableau
+ * 
+ * @param f Fenêtre à agrandir
+ * @return int 1 : l'allocation a réussi \n
+ *             0 : l'allocation a échoué, la fenêtre est inchangée
+ */
+int agranditFenetrePoints(FenetrePoints *f) {
+    int taille = f->maxLen ? 2 * f->maxLen : BLOC;
+    PointDate *points = (PointDate*)malloc(sizeof(PointDate) * taille);
+    if (!points) {
+        return 0;
+    }
+    for (int k = 0; k < f->len; ++k) {
+        points[k] = f->points[(f->debut + k) % f->maxLen];
+    }
+    free(f->points);
+    f->points = points;
+    f->debut = 0;
+    f->maxLen = taille;
+    return 1;
+}
+
+/**
+ * @brief Libére l'espace alloué par la fenêtre **f**
+ * 
+ * @param f 
+ */
+void freeFenetrePoints(FenetrePoints *f) {
+    free(f->points);
+    *f = initFenetrePoints(f->maxPoints, f->duree);
+}
+
+/**
+ * @brief Fait sortir le plus vieux point de la fenêtre **f** et l'enlève de son enveloppe **env_convex**
+ * 
+ * @param env_convex Enveloppe des points de la fenêtre, utilise le champ dyn
+ * @param f Fenêtre glissante contenant au moins un point
+ */
+void retireFenetreConvexHull(ConvexHull *env_convex, FenetrePoints *f) {
+    supprimeEnveloppeConvexDynamique(env_convex, f->points[f->debut].p);
+    f->debut = (f->debut + 1) % f->maxLen;
+    f->len--;
+}
+
+/**
+ * @brief Fait sortir de la fenêtre **f** les points arrivés depuis plus que sa durée à la date **date**, 
+ * et les enlève de l'enveloppe **env_convex**
+ * 
+ * @param env_convex Enveloppe des points de la fenêtre, utilise le champ dyn
+ * @param f Fenêtre glissante
+ * @param date Date courante
+ */
+void expireFenetreConvexHull(ConvexHull *env_convex, FenetrePoints *f, double date) {
+    while (f->len && f->duree > 0 && f->points[f->debut].date <= date - f->duree) {
+        retireFenetreConvexHull(env_convex, f);
+    }
+}
+
+/**
+ * @brief Ajoute le point **p** arrivé à la date **date** à la fenêtre **f** et à son enveloppe **env_convex**, 
+ * puis fait sortir les points en trop ou trop vieux \n
+ * Chaque point entre et sort une seule fois de l'arbre dynamique : une arrivée coûte O(log² n) amorti, 
+ * sans jamais recalculer l'enveloppe de toute la fenêtre
+ * 
+ * @param env_convex Enveloppe des points de la fenêtre, utilise le champ dyn
+ * @param f Fenêtre glissante
+ * @param p Point arrivé
+ * @param date Date d'arrivée, au moins égale à celle du point précédent
+ * @return int 1 : l'ajout a réussi \n
+ *             0 : l'agrandissement de la fenêtre a échoué
+ */
+int ajouteFenetreConvexHull(ConvexHull *env_convex, FenetrePoints *f, Point p, double date) {
+    if (f->len == f->maxLen && !agranditFenetrePoints(f)) {
+        return 0;
+    }
+    f->points[(f->debut + f->len) % f->maxLen] = (PointDate){p, date};
+    f->len++;
+    majEnveloppeConvexDynamique(env_convex, p);
+
+    if (f->maxPoints > 0 && f->len > f->maxPoints) {
+        retireFenetreConvexHull(env_convex, f);
+    }
+    expireFenetreConvexHull(env_convex, f, date);
+    return 1;
+}
+
+// -------------------Fonctions gestions interface graphique-------------------
+
+/**
+ * @brief Attend un clic ou une entrée clavier, actualise la position de la souris en cas de clic
+ * 
+ * @param souris Coordonnées de la souris
+ * @return MLV_Event 
+ */
+MLV_Event actualiseSouris(Point *souris){
+    int souris_x;
+    int souris_y;
+    MLV_Event event_type = MLV_wait_keyboard_or_mouse(NULL, NULL, NULL, &souris_x, &souris_y);
+    if (event_type == MLV_MOUSE_BUTTON) {
+        souris->x = (double)souris_x;
+        souris->y = (double)souris_y;
+    }
+    
+    return event_type;
+}
+
+/**
+ * @brief Prépare le rendu des points d'un ensemble sur une fenêtre de **largeur** par **hauteur** pixels : 
+ * l'image est remplie avec la couleur **fond** et le tampon d'un point est calculé une fois pour toutes
+ * 
+ * @param r Rendu initialisé
+ * @param largeur 
+ * @param hauteur 
+ * @param fond Couleur du fond de la fenêtre
+ * @param couleur Couleur des points
+ * @return int 1 : les allocations ont réussi \n
+ *             0 : l'allocation de l'image ou du tableau des pixels a échoué
+ */
+int initRenduPoints(RenduPoints *r, int largeur, int hauteur, MLV_Color fond, MLV_Color couleur) {
+    r->image = MLV_create_image(largeur, hauteur);
+    r->pixels = (uint8_t*)calloc((size_t)largeur * hauteur, sizeof(uint8_t));
+    if (!r->image || !r->pixels) {
+        if (r->image) {
+            MLV_free_image(r->image);
         }
-        env_convex->curlen++;
-        majConvexHull(env_convex);
+        free(r->pixels);
+        return 0;
+    }
+    MLV_draw_filled_rectangle_on_image(0, 0, largeur, hauteur, fond, r->image);
+    r->largeur = largeur;
+    r->hauteur = hauteur;
+    r->nbDessines = 0;
+    r->couleur = couleur;
+
+    // Pixels du disque plein de rayon RAYON_POINT
+    r->lenTampon = 0;
+    for (int dy = -RAYON_POINT; dy <= RAYON_POINT; ++dy) {
+        for (int dx = -RAYON_POINT; dx <= RAYON_POINT; ++dx) {
+            if (dx * dx + dy * dy <= RAYON_POINT * RAYON_POINT + RAYON_POINT) {
+                r->tampon[r->lenTampon][0] = dx;
+                r->tampon[r->lenTampon][1] = dy;
+                r->lenTampon++;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Colore dans l'image de **r** les pixels du point **p** qui ne le sont pas encore
+ * 
+ * @param r 
+ * @param p 
+ */
+void tamponnePoint(RenduPoints *r, Point p) {
+    int x = (int)p.x;
+    int y = (int)p.y;
+    for (int k = 0; k < r->lenTampon; ++k) {
+        int px = x + r->tampon[k][0];
+        int py = y + r->tampon[k][1];
+        if (px < 0 || py < 0 || px >= r->largeur || py >= r->hauteur || r->pixels[py * r->largeur + px]) {
+            continue;
+        }
+        r->pixels[py * r->largeur + px] = 1;
+        MLV_set_pixel_on_image(px, py, r->couleur, r->image);
+    }
+}
+
+/**
+ * @brief Dessine tous les points de l'ensemble **e** sur la fenêtre en recouvrant son contenu : seuls les points 
+ * ajoutés depuis le dernier appel sont tamponnés dans l'image, qui est ensuite copiée en une fois \n
+ * Le coût d'une image ne dépend pas du nombre de points de l'ensemble, un pixel n'est coloré qu'une fois
+ * 
+ * @param r Rendu des points de **e**
+ * @param e Ensemble dessiné, qui ne fait que grandir d'un appel à l'autre
+ */
+void dessineEnsembleRendu(RenduPoints *r, Ensemble e) {
+    for (; r->nbDessines < e.nbPoints; r->nbDessines++) {
+        tamponnePoint(r, e.tabPoints[r->nbDessines]);
+    }
+    MLV_draw_image(r->image, 0, 0);
+}
+
+/**
+ * @brief Tamponne les points de **e** pas encore dessinés puis recopie sur la fenêtre le rectangle de l'image de **r** 
+ * qui contient la zone **zone**, agrandie de la taille d'un point
+ * 
+ * @param r Rendu des points de **e**
+ * @param e Ensemble dessiné, qui ne fait que grandir d'un appel à l'autre
+ * @param zone Zone à effacer
+ * @param rect Rectangle recopié : x1, y1, x2, y2
+ * @return int 1 : un rectangle a été recopié \n
+ *             0 : la zone est vide ou hors de la fenêtre
+ */
+int restaureZone(RenduPoints *r, Ensemble e, ZoneModifiee zone, int rect[4]) {
+    for (; r->nbDessines < e.nbPoints; r->nbDessines++) {
+        tamponnePoint(r, e.tabPoints[r->nbDessines]);
+    }
+    if (zone.vide) {
+        return 0;
+    }
+
+    // Marge pour les points et les sommets dessinés autour des coordonnées
+    int marge = RAYON_POINT + 1;
+    rect[0] = (int)fmax(zone.min.x - marge, 0);
+    rect[1] = (int)fmax(zone.min.y - marge, 0);
+    rect[2] = (int)fmin(zone.max.x + marge, r->largeur - 1);
+    rect[3] = (int)fmin(zone.max.y + marge, r->hauteur - 1);
+    if (rect[0] > rect[2] || rect[1] > rect[3]) {
+        return 0;
+    }
+    MLV_draw_partial_image(r->image, rect[0], rect[1], rect[2] - rect[0] + 1, rect[3] - rect[1] + 1, rect[0], rect[1]);
+    return 1;
+}
+
+/**
+ * @brief Redessine le côté [**a**, **b**] d'une enveloppe et ses extrémités si il touche le rectangle **rect** : 
+ * un côté qui ne le touche pas n'a pas été effacé
+ * 
+ * @param a 
+ * @param b 
+ * @param rect Rectangle recopié par restaureZone
+ */
+void dessineCoteZone(Point a, Point b, const int rect[4]) {
+    int marge = RAYON_POINT + 1;
+    if (fmax(a.x, b.x) + marge < rect[0] || fmin(a.x, b.x) - marge > rect[2] || 
+        fmax(a.y, b.y) + marge < rect[1] || fmin(a.y, b.y) - marge > rect[3]) {
         return;
     }
+    MLV_draw_filled_circle((int)a.x, (int)a.y, 2, MLV_COLOR_RED);
+    MLV_draw_filled_circle((int)b.x, (int)b.y, 2, MLV_COLOR_RED);
+    MLV_draw_line((int)a.x, (int)a.y, (int)b.x, (int)b.y, MLV_COLOR_RED);
+}
 
-    Vertex *s_i = env_convex->p;
-    Vertex *s_j = s_i->suiv;
-    do {
-        s_i = s_j;
-        s_j = s_j->suiv;
-    } while (triangleDirecte(*p, *(s_i->p), *(s_j->p)) && s_i != env_convex->p);  // Tant que le triangle est directe est qu'on a pas vérifier tous les points
+/**
+ * @brief Redessine seulement la zone **zone** de la fenêtre : le fond et les points de la zone sont recopiés 
+ * depuis l'image de **r**, puis les côtés de l'enveloppe qui touchent la zone sont redessinés \n
+ * Le reste de la fenêtre garde l'image précédente, le nombre de dessins dépend des côtés changés et non de l'ensemble
+ * 
+ * @param r Rendu des points de **e**, déjà affiché en entier sur la fenêtre
+ * @param e Ensemble dessiné, qui ne fait que grandir d'un appel à l'autre
+ * @param env_convex Enveloppe mise à jour avec majEnveloppeConvex
+ * @param zone Zone modifiée par les mises à jour depuis le dernier dessin
+ */
+void dessineZoneModifiee(RenduPoints *r, Ensemble e, ConvexHull *env_convex, ZoneModifiee zone) {
+    int rect[4];
+    if (!restaureZone(r, e, zone, rect)) {
+        return;
+    }
+    Vertex *v = env_convex->p;
+    for (int k = 0; k < env_convex->curlen; ++k, v = v->suiv) {
+        dessineCoteZone(v->p, v->suiv->p, rect);
+    }
+}
 
-    // Si on est sortit de la boucle car tous les triangles sont directes, on arrête là
-    if (triangleDirecte(*p, *(s_i->p), *(s_j->p)) && s_i == env_convex->p) {
-        majConvexHull(env_convex);
+/**
+ * @brief Même dessin que dessineZoneModifiee à partir d'un instantané de l'enveloppe
+ * 
+ * @param r Rendu des points de l'ensemble, déjà affiché en entier sur la fenêtre
+ * @param e Ensemble complet, seuls ses points déjà ajoutés à l'instantané sont dessinés
+ * @param inst Instantané pris par l'affichage
+ */
+void dessineInstantane(RenduPoints *r, Ensemble e, const InstantaneEnveloppe *inst) {
+    int rect[4];
+    e.nbPoints = inst->nbPoints;
+    if (!restaureZone(r, e, inst->zone, rect)) {
         return;
     }
+    for (int k = 0; k < inst->len; ++k) {
+        dessineCoteZone(inst->sommets[k], inst->sommets[(k + 1) % inst->len], rect);
+    }
+}
 
-    // si on à un triangle indirecte
-    // On insére p en tant que nouvelle tête de liste
-    env_convex->p = s_j;
-    if (!ajouteVertexPolygone(&(env_convex->p), p)) {
-        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
-        exit(1);
+/**
+ * @brief Libére l'espace alloué par le rendu **r**
+ * 
+ * @param r 
+ */
+void freeRenduPoints(RenduPoints *r) {
+    MLV_free_image(r->image);
+    free(r->pixels);
+    r->image = NULL;
+    r->pixels = NULL;
+}
+
+/**
+ * @brief Dessine le polygône en tableau **poly** en parcourant ses sommets dans l'ordre du tableau
+ * 
+ * @param poly Polygône à dessiner
+ */
+void dessinePolygoneTab(PolygoneTab poly) {
+    Point *s;
+    Point *suiv;
+    for (int k = 0; k < poly.len; ++k) {
+        s = sommetPolygoneTab(&poly, k);
+        suiv = sommetPolygoneTab(&poly, k + 1);
+        MLV_draw_filled_circle((int)s->x, (int)s->y, 2, MLV_COLOR_RED);
+        MLV_draw_line((int)s->x, (int)s->y, (int)suiv->x, (int)suiv->y, MLV_COLOR_RED);
     }
-    env_convex->curlen++;
-    
-    // Nettoyage avant
-    s_i = env_convex->p->suiv;
-    s_j = s_i->suiv;
-    while (!triangleDirecte(*(env_convex->p->p), *(s_i->p), *(s_j->p))) {
-        freeVertex(s_i, &(env_convex->p));
-        s_i = env_convex->p->suiv;
-        s_j = s_i->suiv;
-        env_convex->curlen--;
+}
+
+/**
+ * @brief Dessine les sommets de l'arbre **a** et les segments qui les relient dans l'ordre lexicographique
+ * 
+ * @param a Arbre d'une chaîne
+ * @param prec Adresse du dernier sommet dessiné, NULL avant le premier
+ */
+void dessineArbreChaine(NoeudChaine *a, Point **prec) {
+    if (!a) {
+        return;
+    }
+    dessineArbreChaine(a->gauche, prec);
+    MLV_draw_filled_circle((int)a->p.x, (int)a->p.y, 2, MLV_COLOR_RED);
+    if (*prec) {
+        MLV_draw_line((int)(*prec)->x, (int)(*prec)->y, (int)a->p.x, (int)a->p.y, MLV_COLOR_RED);
     }
+    *prec = &(a->p);
+    dessineArbreChaine(a->droite, prec);
+}
 
-    // Nettoyage arrière
-    s_i = env_convex->p->prec->prec;
-    s_j = env_convex->p->prec;
-    while (!triangleDirecte(*(env_convex->p->p), *(s_i->p), *(s_j->p))) {
-        freeVertex(s_j, &(env_convex->p));
-        s_i = env_convex->p->prec->prec;
-        s_j = env_convex->p->prec;
-        env_convex->curlen--;
+/**
+ * @brief Dessine l'enveloppe rangée dans les chaînes en arbre de **env_convex** sans passer par un Polygone
+ * 
+ * @param env_convex Enveloppe mise à jour avec majEnveloppeConvexArbre
+ */
+void dessineEnveloppeArbre(ConvexHull *env_convex) {
+    Point *prec = NULL;
+    dessineArbreChaine(env_convex->sup.racine, &prec);
+    prec = NULL;
+    dessineArbreChaine(env_convex->inf.racine, &prec);
+}
+
+/**
+ * @brief Dessine le polygône **poly**
+ * 
+ * @param poly Polygône à dessiner
+ */
+void dessinePolygone(Polygone poly) {
+    Vertex *tete = poly;
+    MLV_draw_filled_circle((int)poly->p.x, (int)poly->p.y, 2, MLV_COLOR_RED);
+    MLV_draw_line((int)poly->p.x, (int)poly->p.y, (int)poly->suiv->p.x, (int)poly->suiv->p.y, MLV_COLOR_RED);
+    poly = poly->suiv;
+    for (; poly != tete; poly = poly->suiv) {
+        MLV_draw_filled_circle((int)poly->p.x, (int)poly->p.y, 2, MLV_COLOR_RED);
+        MLV_draw_line((int)poly->p.x, (int)poly->p.y, (int)poly->suiv->p.x, (int)poly->suiv->p.y, MLV_COLOR_RED);
+    }
+}
+
+// ----------------Publication de l'enveloppe pour l'affichage-----------------
+
+/**
+ * @brief Initialise les trois instantanés vides de **pub** : le premier est publié et déjà pris
+ * 
+ * @param pub 
+ */
+void initPublicationEnveloppe(PublicationEnveloppe *pub) {
+    for (int k = 0; k < 3; ++k) {
+        pub->tampons[k].sommets = NULL;
+        pub->tampons[k].len = 0;
+        pub->tampons[k].maxLen = 0;
+        pub->tampons[k].nbPoints = 0;
+        pub->tampons[k].zone.vide = 1;
+    }
+    atomic_init(&(pub->publie), 0);
+    pub->ecriture = 1;
+    pub->lecture = 2;
+}
+
+/**
+ * @brief Libére l'espace alloué par les instantanés de **pub**
+ * 
+ * @param pub 
+ */
+void freePublicationEnveloppe(PublicationEnveloppe *pub) {
+    for (int k = 0; k < 3; ++k) {
+        free(pub->tampons[k].sommets);
+    }
+    initPublicationEnveloppe(pub);
+}
+
+/**
+ * @brief Détermine si l'affichage a pris le dernier instantané publié dans **pub**
+ * 
+ * @param pub 
+ * @return int 1 : l'instantané publié a été pris \n
+ *             0 : l'instantané publié attend l'affichage
+ */
+int instantanePris(PublicationEnveloppe *pub) {
+    return !(atomic_load(&(pub->publie)) & NOUVEL_INSTANTANE);
+}
+
+/**
+ * @brief Copie les sommets de **env_convex** dans l'instantané du thread de calcul puis l'échange avec 
+ * l'instantané publié, sans verrou \n
+ * Si l'instantané remplacé n'a pas été pris par l'affichage, sa zone est ajoutée au nouveau
+ * 
+ * @param pub 
+ * @param env_convex Enveloppe copiée
+ * @param nbPoints Nombre de points de l'ensemble ajoutés à l'enveloppe
+ * @param zone Zone modifiée depuis la dernière publication, remise à vide
+ * @return int 1 : la publication a réussi \n
+ *             0 : l'agrandissement de l'instantané a échoué
+ */
+int publieEnveloppe(PublicationEnveloppe *pub, ConvexHull *env_convex, int nbPoints, ZoneModifiee *zone) {
+    InstantaneEnveloppe *inst = &(pub->tampons[pub->ecriture]);
+    if (env_convex->curlen > inst->maxLen) {
+        int taille = (2 * inst->maxLen > env_convex->curlen) ? 2 * inst->maxLen : env_convex->curlen;
+        Point *sommets = (Point*)realloc(inst->sommets, sizeof(Point) * taille);
+        if (!sommets) {
+            return 0;
+        }
+        inst->sommets = sommets;
+        inst->maxLen = taille;
+    }
+    Vertex *v = env_convex->p;
+    for (int k = 0; k < env_convex->curlen; ++k, v = v->suiv) {
+        inst->sommets[k] = v->p;
+    }
+    inst->len = env_convex->curlen;
+    inst->nbPoints = nbPoints;
+    inst->zone = *zone;
+    // L'affichage ne fait que lire les instantanés : lire la zone de l'instantané publié est sans danger
+    int publie = atomic_load(&(pub->publie));
+    if (publie & NOUVEL_INSTANTANE) {
+        fusionneZone(&(inst->zone), pub->tampons[publie & ~NOUVEL_INSTANTANE].zone);
+    }
+
+    // L'instantané rendu au thread de calcul est l'ancien instantané publié, ou celui que l'affichage vient de rendre
+    pub->ecriture = atomic_exchange(&(pub->publie), pub->ecriture | NOUVEL_INSTANTANE) & ~NOUVEL_INSTANTANE;
+    zone->vide = 1;
+    return 1;
+}
+
+/**
+ * @brief Prend le dernier instantané publié dans **pub** si l'affichage ne l'a pas encore pris, sans verrou
+ * 
+ * @param pub 
+ * @return InstantaneEnveloppe* Instantané réservé à l'affichage jusqu'au prochain appel, NULL si rien n'a changé
+ */
+InstantaneEnveloppe* prendInstantane(PublicationEnveloppe *pub) {
+    if (instantanePris(pub)) {
+        return NULL;
+    }
+    pub->lecture = atomic_exchange(&(pub->publie), pub->lecture) & ~NOUVEL_INSTANTANE;
+    return &(pub->tampons[pub->lecture]);
+}
+
+/**
+ * @brief Fonction du thread de calcul de l'affichage dynamique : ajoute les points un par un avec majEnveloppeConvex 
+ * et publie un instantané de l'enveloppe dès que l'affichage a pris le précédent, sans jamais l'attendre \n
+ * Avec INSERTIONS_PAR_IMAGE, un instantané est publié toutes les INSERTIONS_PAR_IMAGE insertions et le calcul 
+ * attend que l'affichage l'ait pris
+ * 
+ * @param arg Adresse d'un TravailInsertion
+ * @return void* NULL
+ */
+void* threadInsertion(void *arg) {
+    TravailInsertion *travail = (TravailInsertion*)arg;
+    ZoneModifiee zone = {.vide = 1};
+    travail->reussite = 1;
+
+    int k = 0;
+    while (k < travail->e.nbPoints && !atomic_load(&(travail->arret))) {
+        majEnveloppeConvex(travail->env_convex, travail->e.tabPoints[k]);
+        fusionneZone(&zone, travail->env_convex->zone);
+        k++;
+
+        int image = INSERTIONS_PAR_IMAGE ? !(k % INSERTIONS_PAR_IMAGE) : instantanePris(travail->publication);
+        if (!image) {
+            continue;
+        }
+        while (INSERTIONS_PAR_IMAGE && !instantanePris(travail->publication) && !atomic_load(&(travail->arret))) {
+            sched_yield();
+        }
+        if (!publieEnveloppe(travail->publication, travail->env_convex, k, &zone)) {
+            travail->reussite = 0;
+            break;
+        }
     }
-    majConvexHull(env_convex);
+    // Dernier état, publié même si l'affichage n'a pas pris le précédent
+    if (travail->reussite && !publieEnveloppe(travail->publication, travail->env_convex, k, &zone)) {
+        travail->reussite = 0;
+    }
+    atomic_store(&(travail->fini), 1);
+    return NULL;
 }
 
-// -------------------Fonctions gestions interface graphique-------------------
+// -----------------Fonctions de génération aléatoire de point-----------------
 
 /**
- * @brief Attend un clic ou une entrée clavier, actualise la position de la souris en cas de clic
+ * @brief Avance le compteur **etat** et renvoie un réel uniforme dans [0, 1[ sur 53 bits
  * 
- * @param souris Coordonnées de la souris
- * @return MLV_Event 
+ * @param etat Compteur du flux de nombres aléatoires
+ * @return double 
  */
-MLV_Event actualiseSouris(Point *souris){
-    int souris_x;
-    int souris_y;
-    MLV_Event event_type = MLV_wait_keyboard_or_mouse(NULL, NULL, NULL, &souris_x, &souris_y);
-    if (event_type == MLV_MOUSE_BUTTON) {
-        souris->x = (double)souris_x;
-        souris->y = (double)souris_y;
-
-        // Ajout d'une petite fluctuation pour ne pas avoir deux points superposées
-        souris->x += (double)rand() / RAND_MAX;
-        souris->y += (double)rand() / RAND_MAX;
-    }
-    
-    return event_type;
+double uniforme(uint64_t *etat) {
+    *etat += 0x9E3779B97F4A7C15ULL;
+    return (melange64(*etat) >> 11) * (1.0 / 9007199254740992.0);
 }
 
 /**
- * @brief Dessine tous les points de l'ensemble **e** sur une fenêtre MLV
+ * @brief Génére le point d'indice **k** de la distribution **d** \n
+ * Chaque point a son propre flux de nombres aléatoires, tiré de la graine et de son indice : le point ne dépend 
+ * pas des points générés avant lui, ce qui permet de générer un ensemble par tranches sur plusieurs threads 
+ * et d'obtenir les mêmes points quel que soit le nombre de threads \n
+ * Les directions sont tirées par rejet dans le disque unité plutôt qu'avec cos et sin
  * 
- * @param e Ensemble dessiné
+ * @param d Distribution des points
+ * @param k Indice du point
+ * @return Point Point généré
  */
-void dessineEnsemble(Ensemble e) {
-    int k;
-    for (k = 0; k < e.nbPoints; ++k) {
-        MLV_draw_filled_circle((int)e.tabPoints[k].x, (int)e.tabPoints[k].y, 2, MLV_COLOR_BLUE);
+Point generationPoint(const Distribution *d, long k) {
+    uint64_t etat = melange64(d->graine ^ melange64((uint64_t)k));
+    double rayon = d->rayon + k * d->pas;
+    Point p;
+
+    // Distribution dans un carré
+    if (d->forme == 0) {
+        p.x = (d->centre - rayon) + (2 * rayon) * uniforme(&etat);
+        p.y = (d->centre - rayon) + (2 * rayon) * uniforme(&etat);
+        return p;
     }
+
+    // Direction aléatoire : point uniforme du disque unité ramené sur le cercle
+    double u, v, carre;
+    do {
+        u = 2 * uniforme(&etat) - 1;
+        v = 2 * uniforme(&etat) - 1;
+        carre = u * u + v * v;
+    } while (carre >= 1 || carre == 0);
+    double distCentre = rayon / sqrt(carre);  // Sur le cercle
+    if (d->forme == 1) {  // Distance aléatoire au centre dans un disque
+        distCentre *= uniforme(&etat);
+    }
+    p.x = d->centre + distCentre * u;
+    p.y = d->centre + distCentre * v;
+    return p;
 }
 
 /**
- * @brief Dessine le polygône **poly**
+ * @brief Fonction d'un thread de la génération de points : remplit sa tranche du tableau
  * 
- * @param poly Polygône à dessiner
+ * @param arg Adresse d'un TravailGeneration
+ * @return void* NULL
  */
-void dessinePolygone(Polygone poly) {
-    Vertex *tete = poly;
-    MLV_draw_filled_circle((int)poly->p->x, (int)poly->p->y, 2, MLV_COLOR_RED);
-    MLV_draw_line((int)poly->p->x, (int)poly->p->y, (int)poly->suiv->p->x, (int)poly->suiv->p->y, MLV_COLOR_RED);
-    poly = poly->suiv;
-    for (; poly != tete; poly = poly->suiv) {
-        MLV_draw_filled_circle((int)poly->p->x, (int)poly->p->y, 2, MLV_COLOR_RED);
-        MLV_draw_line((int)poly->p->x, (int)poly->p->y, (int)poly->suiv->p->x, (int)poly->suiv->p->y, MLV_COLOR_RED);
+void* threadGeneration(void *arg) {
+    TravailGeneration *travail = (TravailGeneration*)arg;
+    for (int k = travail->debut; k < travail->fin; ++k) {
+        travail->points[k] = generationPoint(&(travail->d), k);
     }
+    return NULL;
 }
 
-// -----------------Fonctions de génération aléatoire de point-----------------
-
 /**
- * @brief Génére un point dans une forme de centre **centre** et de demi-côté **rayon**
+ * @brief Complète **e** jusqu'à **nbPoints** points avec les points de la distribution **d** : 
+ * le point rangé à l'indice k est le point d'indice k de la distribution \n
+ * Le tableau est rempli d'un coup par tranches d'au moins POINTS_PAR_THREAD points réparties sur **nbThreads** threads, 
+ * le résultat ne dépend que de la graine
  * 
- * @param centre Centre de la forme
- * @param rayon rayon du demi-côté
- * @param forme 0 : Carré \n
- *              1 : Cercle
- * @return Point Point généré
+ * @param e Ensemble complété
+ * @param d Distribution des points
+ * @param nbPoints Nombre de points de l'ensemble à la fin
+ * @param nbThreads Nombre maximal de threads
+ * @return int 1 : la génération a réussi \n
+ *             0 : l'allocation du tableau a échoué
  */
-Point generationPoint(int centre, int rayon, int forme) {
-    Point p;
-    
-    // Distribution dans un carré
-    if (forme == 0) {
-        p.x = (centre - rayon) + (2 * rayon) * (double)rand() / RAND_MAX;
-        p.y = (centre - rayon) + (2 * rayon) * (double)rand() / RAND_MAX;
-        
-    } else {  // Distribution dans un cercle
-        p.x = centre;
-        p.y = centre;
-        double distCentre = rayon * (double)rand() / RAND_MAX;  // distance par rapport au centre
-        double angle = 2 * M_PI * (double)rand() / RAND_MAX;  // Angle aléatoire
-        p.x += distCentre * cos(angle);
-        p.y += distCentre * sin(angle);
+int genereEnsemble(Ensemble *e, const Distribution *d, int nbPoints, int nbThreads) {
+    if (nbPoints <= e->nbPoints) {
+        return 1;
     }
-    return p;
+    if (!reserveEnsemble(e, nbPoints)) {
+        return 0;
+    }
+    int nbGeneres = nbPoints - e->nbPoints;
+    if (nbThreads > nbGeneres / POINTS_PAR_THREAD) {
+        nbThreads = nbGeneres / POINTS_PAR_THREAD;
+    }
+    if (nbThreads < 1) {
+        nbThreads = 1;
+    }
+
+    TravailGeneration *travaux = (TravailGeneration*)malloc(sizeof(TravailGeneration) * nbThreads);
+    pthread_t *threads = (pthread_t*)malloc(sizeof(pthread_t) * nbThreads);
+    if (!travaux || !threads) {
+        free(travaux);
+        free(threads);
+        return 0;
+    }
+    for (int k = 0; k < nbThreads; ++k) {
+        travaux[k].points = e->tabPoints;
+        travaux[k].debut = e->nbPoints + (int)((long long)nbGeneres * k / nbThreads);
+        travaux[k].fin = e->nbPoints + (int)((long long)nbGeneres * (k + 1) / nbThreads);
+        travaux[k].d = *d;
+    }
+
+    // Une tranche dont le thread n'a pas pu être créé est générée par le thread appelant
+    int nbLances = 0;
+    while (nbLances < nbThreads - 1 && !pthread_create(&(threads[nbLances]), NULL, threadGeneration, &(travaux[nbLances]))) {
+        nbLances++;
+    }
+    for (int k = nbLances; k < nbThreads; ++k) {
+        threadGeneration(&(travaux[k]));
+    }
+    for (int k = 0; k < nbLances; ++k) {
+        pthread_join(threads[k], NULL);
+    }
+
+    e->nbPoints = nbPoints;
+    free(travaux);
+    free(threads);
+    return 1;
 }
 
 // ---------------------------Vartientes du programme--------------------------
@@ -475,6 +3338,12 @@ void mainEnveloppeSouris() {
     MLV_create_window("Enveloppe convexe", "", longueur_fen, largeur_fen);
     MLV_clear_window(MLV_rgba(30, 30, 30, 255));
     MLV_actualise_window();
+
+    RenduPoints rendu;
+    if (!initRenduPoints(&rendu, longueur_fen, largeur_fen, MLV_rgba(30, 30, 30, 255), MLV_COLOR_BLUE)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
     
     // Actualise la position de la souris 
     event_type = actualiseSouris(&souris);
@@ -484,38 +3353,25 @@ void mainEnveloppeSouris() {
             exit(1);
         }
 
-        // Si on a réalloué la mémoire il faut rediriger les pointeurs de l'enveloppe convexe vers la nouvelle zone mémoire
-        if (!((e.nbPoints - 1) % BLOC)) {
-            freePolygone(&(env_convex.p));
-            env_convex = initConvexHull();
-            for (int l = 0; l < e.nbPoints; ++l) {
-                majEnveloppeConvex(&env_convex, &(e.tabPoints[l]));
-            }
-        } else {  // Sinon on met à jour juste avec le dernier point ajouter
-            majEnveloppeConvex(&env_convex, &(e.tabPoints[e.nbPoints - 1]));
-        }
+        // Les sommets de l'enveloppe ont leur propre copie du point, une réallocation de l'ensemble ne les concerne pas
+        majEnveloppeConvex(&env_convex, e.tabPoints[e.nbPoints - 1]);
 
-        printf("ENVELOPPE CONVEXE INFO :\n");
-        printf("    curlen = %d \n", env_convex.curlen);
-        printf("    maxlen = %d \n", env_convex.maxlen);
-        printf("    avg = %f \n", env_convex.avg);
-        printf("    nbMaj = %d \n", env_convex.nbMaj);
-        printf("\n");
+        printInfoConvexHull(env_convex);
 
-        dessineEnsemble(e);
-        dessinePolygone(env_convex.p);
+        // Seule la zone changée par le nouveau point est redessinée
+        dessineZoneModifiee(&rendu, e, &env_convex, env_convex.zone);
 
         MLV_actualise_window();
-        MLV_clear_window(MLV_rgba(30, 30, 30, 255));
         
         event_type = actualiseSouris(&souris);
     }
 
+    freeRenduPoints(&rendu);
     MLV_free_window();
 
     // Libération de la mémoire
     free(e.tabPoints);
-    freePolygone(&(env_convex.p));
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
 }
 
 /**
@@ -528,6 +3384,7 @@ void mainEnveloppeSouris() {
  * @param centre Centre de la forme
  * @param rayon rayon initial du demi-côté
  * @param nbPoints Nombre de points à générer
+ * @param nbThreads Nombre de threads du calcul de l'enveloppe sans affichage dynamique
  * @param forme 0 : Carré \n
  *              1 : Cercle
  * @param spiral : distribution pseudo-spiral des points        
@@ -535,11 +3392,15 @@ void mainEnveloppeSouris() {
  *                  0 : Affichage unique une fois l'algorithme fini
  * 
  */
-void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int spiral, int dynamique) {
+void mainEnveloppeForme(int centre, double rayon, int nbPoints, int nbThreads, int forme, int spiral, int dynamique) {
     ConvexHull env_convex = initConvexHull();
 
-    Point *tabPoints = (Point*)malloc(nbPoints * sizeof(Point));
-    Ensemble e = initEnsemble(tabPoints, nbPoints);
+    // Tous les points sont connus à l'avance, le tableau est dimensionné une seule fois
+    Ensemble e = initEnsemble(NULL, 0);
+    if (!reserveEnsemble(&e, nbPoints)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
 
     MLV_Keyboard_button sym = MLV_KEYBOARD_NONE;  // Récupére les potentielles entrées de touches
     int longueur_fen = 500;
@@ -548,49 +3409,77 @@ void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int s
     MLV_clear_window(MLV_rgba(30, 30, 30, 255));
     MLV_actualise_window();
 
+    RenduPoints rendu;
+    if (!initRenduPoints(&rendu, longueur_fen, largeur_fen, MLV_rgba(30, 30, 30, 255), MLV_COLOR_BLUE)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
+
     double pas = 0;  /* Détérmine le pas pour augmenter le rayon au fur et à 
                         mesure de l'ajout des points dans le cas d'une distribution spirale */
     if (spiral) {
         pas = ((largeur_fen - 20) - (centre + rayon)) / nbPoints;
     }
 
-    Point pointAleat;
-    int k = 0;
-    while (k < nbPoints && sym != MLV_KEYBOARD_ESCAPE) {
-        //Génére un point de type double dans le carré
-        pointAleat = generationPoint(centre, rayon, forme);
-
-        if (!ajoutePointEnsemble(&e, pointAleat)) {
-            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
-            exit(1);
-        }
+    // Suite de points tirée au hasard à chaque lancement, le point d'indice k est le même qu'il soit généré seul ou par tranches
+    Distribution d = {((uint64_t)rand() << 32) ^ (uint64_t)rand(), centre, rayon, pas, forme};
 
-        majEnveloppeConvex(&env_convex, &(e.tabPoints[k]));
+    // Tous les points sont générés d'un coup, l'affichage dynamique ne montre que ceux déjà ajoutés
+    if (!genereEnsemble(&e, &d, nbPoints, nbThreads)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
 
-        if (spiral) {
-            rayon += pas;
-        }
+    // Les points sont ajoutés par un thread de calcul qui n'attend jamais l'affichage, la fenêtre reste 
+    // pilotée par ce thread qui dessine à chaque image le dernier instantané publié
+    PublicationEnveloppe publication;
+    initPublicationEnveloppe(&publication);
+    TravailInsertion travail = {.e = e, .env_convex = &env_convex, .publication = &publication, .reussite = 1};
+    atomic_init(&(travail.arret), 0);
+    atomic_init(&(travail.fini), 0);
+    pthread_t calcul;
+    if (dynamique && pthread_create(&calcul, NULL, threadInsertion, &travail)) {
+        dynamique = 0;  // Sans thread de calcul, l'enveloppe est calculée en une fois
+    }
+    if (dynamique) {
+        int fini = 0;
+        while (!fini) {
+            MLV_wait_milliseconds(1000 / IMAGES_PAR_SECONDE);
+            fini = atomic_load(&(travail.fini));  // Lu avant de prendre l'instantané pour ne pas manquer le dernier
 
-        if (dynamique) {
-            dessineEnsemble(e);
-            dessinePolygone(env_convex.p);
+            InstantaneEnveloppe *inst = prendInstantane(&publication);
+            if (inst) {
+                dessineInstantane(&rendu, e, inst);
+                MLV_actualise_window();
+            }
 
-            MLV_actualise_window();
-            MLV_clear_window(MLV_rgba(30, 30, 30, 255));
+            MLV_get_event(&sym, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+            if (sym == MLV_KEYBOARD_SPACE || sym == MLV_KEYBOARD_ESCAPE) {
+                atomic_store(&(travail.arret), 1);
+                break;
+            }
+        }
+        pthread_join(calcul, NULL);
+        if (!travail.reussite) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+            exit(1);
         }
-
-        MLV_get_event(&sym, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
         if (sym == MLV_KEYBOARD_SPACE) {
             dynamique = 0;
         }
-
-        k++;
     }
+    freePublicationEnveloppe(&publication);
     if (sym == MLV_KEYBOARD_ESCAPE) {
         exit(0);
     }
 
-    dessineEnsemble(e);
+    // Sans affichage dynamique, ou si il a été coupé, l'enveloppe de tout l'ensemble est calculée en une fois
+    if (!dynamique && !enveloppeConvexeParallele(&env_convex, e, nbThreads)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
+
+    dessineEnsembleRendu(&rendu, e);
     dessinePolygone(env_convex.p);
 
     MLV_actualise_window();
@@ -598,11 +3487,409 @@ void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int s
     // Attend une entrée utilisateur pour quitter le programme
     MLV_wait_keyboard_or_mouse(NULL, NULL, NULL, NULL, NULL);
 
+    freeRenduPoints(&rendu);
     MLV_free_window();
 
     // Libération de la mémoire
     free(e.tabPoints);
-    freePolygone(&(env_convex.p));
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+}
+
+/**
+ * @brief Calcule sans fenêtre MLV l'enveloppe convexe des points lus dans **f** 
+ * puis affiche ses sommets et ses informations
+ * 
+ * @param f Fichier contenant les points, deux coordonnées par ligne
+ * @param moteur MOTEUR_INCREMENTAL : Ajout point par point \n
+ *               MOTEUR_BATCH : Calcul en une seule fois \n
+ *               MOTEUR_TABLEAU : Ajout point par point dans un tableau circulaire \n
+ *               MOTEUR_ARBRE : Ajout point par point dans deux arbres équilibrés \n
+ *               MOTEUR_PARALLELE : Calcul en une seule fois sur plusieurs threads
+ * @param nbThreads Nombre de threads du moteur MOTEUR_PARALLELE
+ * @return int 0 : Succès \n
+ *             1 : Echec d'une allocation de mémoire
+ */
+int mainEnveloppeFichier(FILE *f, int moteur, int nbThreads) {
+    ConvexHull env_convex = initConvexHull();
+
+    Point *tabPoints = (Point*)malloc(BLOC * sizeof(Point));
+    Ensemble e = initEnsemble(tabPoints, BLOC);
+    if (!tabPoints || !lectureEnsemble(f, &e)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        free(e.tabPoints);
+        return 1;
+    }
+
+    if (moteur == MOTEUR_BATCH) {
+        if (!enveloppeConvexeEnsemble(&env_convex, e)) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            free(e.tabPoints);
+            return 1;
+        }
+    } else if (moteur == MOTEUR_PARALLELE) {
+        if (!enveloppeConvexeParallele(&env_convex, e, nbThreads)) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            free(e.tabPoints);
+            return 1;
+        }
+    } else if (moteur == MOTEUR_TABLEAU) {
+        for (int k = 0; k < e.nbPoints; ++k) {
+            majEnveloppeConvexTab(&env_convex, e.tabPoints[k]);
+        }
+    } else if (moteur == MOTEUR_ARBRE) {
+        for (int k = 0; k < e.nbPoints; ++k) {
+            majEnveloppeConvexArbre(&env_convex, e.tabPoints[k]);
+        }
+        if (!enveloppeArbreVersPolygone(&env_convex)) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            free(e.tabPoints);
+            return 1;
+        }
+    } else {
+        for (int k = 0; k < e.nbPoints; ++k) {
+            majEnveloppeConvex(&env_convex, e.tabPoints[k]);
+        }
+    }
+
+    printPolygone(env_convex.p);
+    printPolygoneTab(env_convex.tab);
+    printf("\n");
+    printInfoConvexHull(env_convex);
+
+    // Libération de la mémoire
+    free(e.tabPoints);
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+    freePolygoneTab(&(env_convex.tab));
+    freeChaine(&(env_convex.sup));
+    freeChaine(&(env_convex.inf));
+    return 0;
+}
+
+/**
+ * @brief Calcule sans fenêtre MLV l'enveloppe convexe des points lus au fur et à mesure dans **f** \n
+ * Aucun ensemble n'est construit : les points intérieurs sont oubliés dès leur lecture et seuls 
+ * les sommets de l'enveloppe sont gardés en mémoire, ce qui permet de traiter un flux sans fin
+ * 
+ * @param f Fichier contenant les points, deux coordonnées par ligne
+ * @return int 0 : Succès
+ */
+int mainEnveloppeFlux(FILE *f) {
+    ConvexHull env_convex = initConvexHull();
+    BlocPoints bloc;
+    Point octogone[8];
+    int fin = 0;
+
+    // Les points sont lus par blocs et classés d'un coup contre l'octogone des points extrêmes
+    while (!fin) {
+        bloc.nbPoints = 0;
+        while (bloc.nbPoints < BLOC_POINTS && fscanf(f, "%lf %lf", &(bloc.x[bloc.nbPoints]), &(bloc.y[bloc.nbPoints])) == 2) {
+            bloc.nbPoints++;
+        }
+        fin = bloc.nbPoints < BLOC_POINTS;
+
+        uint64_t masque = UINT64_MAX;
+        if (env_convex.curlen >= 3) {
+            masque = masqueExterieur(&bloc, octogone, octogoneDirect(env_convex.extremes, octogone));
+        }
+        // L'octogone ne fait que grandir pendant le bloc, un point écarté reste dans l'enveloppe
+        for (int k = 0; k < bloc.nbPoints; ++k) {
+            if (masque >> k & 1) {
+                majEnveloppeConvex(&env_convex, (Point){bloc.x[k], bloc.y[k]});
+            } else {
+                env_convex.nbRejets++;
+                majConvexHull(&env_convex);
+            }
+        }
+    }
+    if (!feof(f)) {
+        fprintf(stderr, "Lecture interrompue après %d points : ligne mal formée\n", env_convex.nbMaj);
+    }
+
+    printPolygone(env_convex.p);
+    printf("\n");
+    printInfoConvexHull(env_convex);
+
+    // Libération de la mémoire
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+    return 0;
+}
+
+/**
+ * @brief Calcule sans fenêtre MLV l'enveloppe convexe d'un ensemble qui change au fur et à mesure 
+ * des lignes de **f** : une ligne "x y" ajoute le point, une ligne "s x y" l'enlève
+ * 
+ * @param f Fichier contenant les opérations, une par ligne
+ * @return int 0 : Succès \n
+ *             1 : Erreur d'allocation de la mémoire
+ */
+int mainEnveloppeDynamique(FILE *f) {
+    ConvexHull env_convex = initConvexHull();
+    char ligne[256];
+    int nbLignes = 0;
+    Point p;
+
+    while (fgets(ligne, sizeof(ligne), f)) {
+        nbLignes++;
+        if (sscanf(ligne, "%lf %lf", &(p.x), &(p.y)) == 2) {
+            majEnveloppeConvexDynamique(&env_convex, p);
+        } else if (sscanf(ligne, " s %lf %lf", &(p.x), &(p.y)) == 2) {
+            if (!supprimeEnveloppeConvexDynamique(&env_convex, p)) {
+                fprintf(stderr, "Ligne %d : le point %f %f n'est pas dans l'ensemble\n", nbLignes, p.x, p.y);
+            }
+        } else if (strspn(ligne, " \t\r\n") != strlen(ligne)) {
+            fprintf(stderr, "Lecture interrompue à la ligne %d : ligne mal formée\n", nbLignes);
+            break;
+        }
+    }
+
+    int retour = 0;
+    if (enveloppeDynamiqueVersPolygone(&env_convex)) {
+        printPolygone(env_convex.p);
+        printf("\n");
+        printInfoConvexHull(env_convex);
+    } else {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        retour = 1;
+    }
+
+    // Libération de la mémoire
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+    freeArbreDynamique(env_convex.dyn);
+    return retour;
+}
+
+/**
+ * @brief Calcule sans fenêtre MLV l'enveloppe convexe des derniers points lus dans **f** : 
+ * une ligne "x y date" ajoute un point daté, une ligne "x y" un point dont la date est son rang d'arrivée
+ * 
+ * @param f Fichier contenant les points, un par ligne dans l'ordre des dates
+ * @param maxPoints Nombre maximal de points gardés, 0 : pas de limite
+ * @param duree Âge maximal des points gardés, 0 : pas de limite
+ * @return int 0 : Succès \n
+ *             1 : Erreur d'allocation de la mémoire
+ */
+int mainEnveloppeFenetre(FILE *f, int maxPoints, double duree) {
+    ConvexHull env_convex = initConvexHull();
+    FenetrePoints fenetre = initFenetrePoints(maxPoints, duree);
+    char ligne[256];
+    int nbPoints = 0;
+    Point p;
+    double date;
+    int retour = 0;
+
+    while (fgets(ligne, sizeof(ligne), f)) {
+        int nbLus = sscanf(ligne, "%lf %lf %lf", &(p.x), &(p.y), &date);
+        if (nbLus < 2) {
+            if (strspn(ligne, " \t\r\n") != strlen(ligne)) {
+                fprintf(stderr, "Lecture interrompue après %d points : ligne mal formée\n", nbPoints);
+                break;
+            }
+            continue;
+        }
+        if (nbLus == 2) {
+            date = nbPoints;
+        }
+        if (!ajouteFenetreConvexHull(&env_convex, &fenetre, p, date)) {
+            retour = 1;
+            break;
+        }
+        nbPoints++;
+    }
+
+    if (!retour && enveloppeDynamiqueVersPolygone(&env_convex)) {
+        printPolygone(env_convex.p);
+        printf("\n");
+        printInfoConvexHull(env_convex);
+    } else {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        retour = 1;
+    }
+
+    // Libération de la mémoire
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+    freeArbreDynamique(env_convex.dyn);
+    freeFenetrePoints(&fenetre);
+    return retour;
+}
+
+// ---------------------Banc d'essai des moteurs de calcul---------------------
+
+/**
+ * @brief Renvoie le temps écoulé depuis une origine fixe, insensible aux changements de l'heure du système
+ * 
+ * @return double Temps en secondes
+ */
+double chronometre(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Compare deux points dans l'ordre lexicographique, pour qsort
+ * 
+ * @param a Adresse d'un Point
+ * @param b Adresse d'un Point
+ * @return int 
+ */
+int compareCoordonnees(const void *a, const void *b) {
+    return ordrePoints(*(const Point*)a, *(const Point*)b);
+}
+
+/**
+ * @brief Remplit **e** avec **nbPoints** points de la distribution **distribution**, toujours les mêmes 
+ * pour une distribution et une taille données
+ * 
+ * @param e Ensemble rempli, vide au départ
+ * @param distribution 0 : carré, 1 : disque, 2 : spirale (disque qui grandit comme dans mainEnveloppeForme) \n
+ *                     3 : points sur un cercle (tous sommets de l'enveloppe) \n
+ *                     4 : carré trié dans l'ordre lexicographique (chaque point est un nouveau sommet)
+ * @param nbPoints Nombre de points générés
+ * @param nbThreads Nombre maximal de threads de la génération
+ * @return int 1 : la génération a réussi \n
+ *             0 : l'allocation du tableau a échoué
+ */
+int genereDistribution(Ensemble *e, int distribution, int nbPoints, int nbThreads) {
+    const int formes[] = {0, 1, 1, 2, 0};
+    Distribution d = {BENCHMARK_GRAINE, 250, 230, 0, formes[distribution]};
+    if (distribution == 2) {
+        d.rayon = 10;
+        d.pas = 220.0 / nbPoints;
+    }
+    if (!genereEnsemble(e, &d, nbPoints, nbThreads)) {
+        return 0;
+    }
+
+    if (distribution == 4) {
+        qsort(e->tabPoints, e->nbPoints, sizeof(Point), compareCoordonnees);
+    }
+    return 1;
+}
+
+/**
+ * @brief Génère l'ensemble d'une mesure puis chronomètre le calcul de son enveloppe par le moteur **moteur**
+ * 
+ * @param distribution Distribution des points, voir genereDistribution
+ * @param nbPoints Taille de l'ensemble
+ * @param moteur MOTEUR_INCREMENTAL, MOTEUR_BATCH ou MOTEUR_PARALLELE
+ * @param nbThreads Nombre de threads du moteur MOTEUR_PARALLELE
+ * @param m Mesure remplie, sauf la mémoire
+ * @return int 1 : la mesure a réussi \n
+ *             0 : échec d'une allocation de mémoire
+ */
+int mesureEnveloppe(int distribution, int nbPoints, int moteur, int nbThreads, MesureBenchmark *m) {
+    ConvexHull env_convex = initConvexHull();
+    Ensemble e = initEnsemble(NULL, 0);
+    if (!genereDistribution(&e, distribution, nbPoints, nbThreads)) {
+        free(e.tabPoints);
+        return 0;
+    }
+
+    int reussite = 1;
+    double debut = chronometre();
+    if (moteur == MOTEUR_BATCH) {
+        reussite = enveloppeConvexeEnsemble(&env_convex, e);
+    } else if (moteur == MOTEUR_PARALLELE) {
+        reussite = enveloppeConvexeParallele(&env_convex, e, nbThreads);
+    } else {
+        for (int k = 0; k < e.nbPoints; ++k) {
+            majEnveloppeConvex(&env_convex, e.tabPoints[k]);
+        }
+    }
+    m->nsParPoint = (chronometre() - debut) * 1e9 / nbPoints;
+    m->curlen = env_convex.curlen;
+    m->maxlen = env_convex.maxlen;
+    m->avg = env_convex.avg;
+    m->nbMaj = env_convex.nbMaj;
+
+    free(e.tabPoints);
+    freePolygone(&(env_convex.p), &(env_convex.reserve));
+    return reussite;
+}
+
+/**
+ * @brief Fait une mesure dans un processus fils, pour que le pic de mémoire relevé soit celui de la mesure seule 
+ * et que la mémoire des mesures précédentes ne fausse pas la suivante
+ * 
+ * @param distribution Distribution des points, voir genereDistribution
+ * @param nbPoints Taille de l'ensemble
+ * @param moteur MOTEUR_INCREMENTAL, MOTEUR_BATCH ou MOTEUR_PARALLELE
+ * @param nbThreads Nombre de threads du moteur MOTEUR_PARALLELE
+ * @param m Mesure remplie
+ * @return int 1 : la mesure a réussi \n
+ *             0 : la mesure a échoué
+ */
+int mesureProcessus(int distribution, int nbPoints, int moteur, int nbThreads, MesureBenchmark *m) {
+    int tube[2];
+    if (pipe(tube)) {
+        return 0;
+    }
+    fflush(stdout);
+    pid_t fils = fork();
+    if (fils < 0) {
+        close(tube[0]);
+        close(tube[1]);
+        return 0;
+    }
+    if (!fils) {
+        close(tube[0]);
+        int reussite = mesureEnveloppe(distribution, nbPoints, moteur, nbThreads, m);
+        struct rusage ressources;
+        getrusage(RUSAGE_SELF, &ressources);
+        m->memoire = ressources.ru_maxrss;
+        reussite = reussite && write(tube[1], m, sizeof(MesureBenchmark)) == sizeof(MesureBenchmark);
+        _exit(reussite ? 0 : 1);
+    }
+
+    close(tube[1]);
+    int reussite = read(tube[0], m, sizeof(MesureBenchmark)) == sizeof(MesureBenchmark);
+    close(tube[0]);
+    int statut;
+    if (waitpid(fils, &statut, 0) < 0 || !WIFEXITED(statut) || WEXITSTATUS(statut)) {
+        return 0;
+    }
+    return reussite;
+}
+
+/**
+ * @brief Mesure les moteurs incrémental, batch et parallèle sur chaque distribution et sur des ensembles 
+ * de 10³ à **tailleMax** points, puis affiche une ligne par mesure \n
+ * Un moteur qui dépasse BENCHMARK_DUREE_MAX secondes n'est plus mesuré sur les tailles suivantes de la distribution
+ * 
+ * @param tailleMax Taille maximale des ensembles
+ * @param nbThreads Nombre de threads du moteur parallèle
+ * @return int 0 : Succès \n
+ *             1 : Une mesure a échoué
+ */
+int mainBenchmark(int tailleMax, int nbThreads) {
+    const char *distributions[] = {"carre", "disque", "spirale", "cercle", "trie"};
+    const char *nomsMoteurs[] = {"incremental", "batch", "parallele"};
+    int moteurs[] = {MOTEUR_INCREMENTAL, MOTEUR_BATCH, MOTEUR_PARALLELE};
+    int retour = 0;
+
+    printf("%-8s %10s %-12s %12s %9s %9s %12s %10s %12s\n", 
+           "forme", "points", "moteur", "ns/point", "curlen", "maxlen", "avg", "nbMaj", "memoire(Ko)");
+    for (int d = 0; d < 5; ++d) {
+        int trop_long[3] = {0, 0, 0};
+        for (long nbPoints = 1000; nbPoints <= tailleMax; nbPoints *= 10) {
+            for (int k = 0; k < 3; ++k) {
+                if (trop_long[k]) {
+                    printf("%-8s %10ld %-12s %12s\n", distributions[d], nbPoints, nomsMoteurs[k], "-");
+                    continue;
+                }
+                MesureBenchmark m;
+                if (!mesureProcessus(d, nbPoints, moteurs[k], nbThreads, &m)) {
+                    printf("%-8s %10ld %-12s %12s\n", distributions[d], nbPoints, nomsMoteurs[k], "echec");
+                    retour = 1;
+                    continue;
+                }
+                printf("%-8s %10ld %-12s %12.1f %9d %9d %12.3f %10d %12ld\n", distributions[d], nbPoints, nomsMoteurs[k], 
+                       m.nsParPoint, m.curlen, m.maxlen, m.avg, m.nbMaj, m.memoire);
+                trop_long[k] = m.nsParPoint * nbPoints * 1e-9 > BENCHMARK_DUREE_MAX;
+            }
+        }
+    }
+    return retour;
 }
 
 // ------------------------------------Menu------------------------------------
@@ -808,15 +4095,133 @@ void menu2(int largeurFen, int hauteurFen, int *nbPoints, int *dynamique, int *f
 
 // ----------------------------Programme principale----------------------------
 
-int main(void) {
+/**
+ * @brief Lit les arguments de la ligne de commande et lance le calcul sans fenêtre \n
+ * Utilisation : ./a.out [-m incremental|batch|flux|tableau|arbre|parallele|dynamique|fenetre] [-t threads] [-n points] [-d duree] fichier (- pour l'entrée standard) \n
+ * ou : ./a.out -b taille [-t threads] pour le banc d'essai des moteurs
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int Code de retour du programme
+ */
+int mainSansFenetre(int argc, char *argv[]) {
+    int moteur = MOTEUR_INCREMENTAL;
+    int nbThreads = nombreCoeurs();
+    int maxPoints = 0;  // Taille de la fenêtre glissante, 0 : pas de limite
+    double duree = 0;  // Durée de la fenêtre glissante, 0 : pas de limite
+    int tailleBenchmark = 0;  // Taille maximale des ensembles du banc d'essai, 0 : pas de banc d'essai
+    char *nomFichier = NULL;
+
+    for (int k = 1; k < argc; ++k) {
+        if (!strcmp(argv[k], "-m") && k + 1 < argc) {
+            k++;
+            if (!strcmp(argv[k], "incremental")) {
+                moteur = MOTEUR_INCREMENTAL;
+            } else if (!strcmp(argv[k], "batch")) {
+                moteur = MOTEUR_BATCH;
+            } else if (!strcmp(argv[k], "flux")) {
+                moteur = MOTEUR_FLUX;
+            } else if (!strcmp(argv[k], "tableau")) {
+                moteur = MOTEUR_TABLEAU;
+            } else if (!strcmp(argv[k], "arbre")) {
+                moteur = MOTEUR_ARBRE;
+            } else if (!strcmp(argv[k], "parallele")) {
+                moteur = MOTEUR_PARALLELE;
+            } else if (!strcmp(argv[k], "dynamique")) {
+                moteur = MOTEUR_DYNAMIQUE;
+            } else if (!strcmp(argv[k], "fenetre")) {
+                moteur = MOTEUR_FENETRE;
+            } else {
+                fprintf(stderr, "Moteur inconnu : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!strcmp(argv[k], "-t") && k + 1 < argc) {
+            k++;
+            nbThreads = atoi(argv[k]);
+            if (nbThreads < 1) {
+                fprintf(stderr, "Nombre de threads invalide : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!strcmp(argv[k], "-b") && k + 1 < argc) {
+            k++;
+            tailleBenchmark = atoi(argv[k]);
+            if (tailleBenchmark < 1000) {
+                fprintf(stderr, "Taille maximale du banc d'essai invalide (au moins 1000) : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!strcmp(argv[k], "-n") && k + 1 < argc) {
+            k++;
+            maxPoints = atoi(argv[k]);
+            if (maxPoints < 1) {
+                fprintf(stderr, "Taille de fenêtre invalide : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!strcmp(argv[k], "-d") && k + 1 < argc) {
+            k++;
+            duree = atof(argv[k]);
+            if (duree <= 0) {
+                fprintf(stderr, "Durée de fenêtre invalide : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!nomFichier) {
+            nomFichier = argv[k];
+        } else {
+            nomFichier = NULL;
+            break;
+        }
+    }
+    if (tailleBenchmark) {
+        return mainBenchmark(tailleBenchmark, nbThreads);
+    }
+    if (!nomFichier) {
+        fprintf(stderr, "Utilisation : %s [-m incremental|batch|flux|tableau|arbre|parallele|dynamique|fenetre] [-t threads] [-n points] [-d duree] fichier (- pour l'entrée standard)\n", argv[0]);
+        fprintf(stderr, "         ou : %s -b taille [-t threads] (banc d'essai jusqu'à taille points)\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = stdin;
+    if (strcmp(nomFichier, "-")) {
+        f = fopen(nomFichier, "r");
+        if (!f) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+            return 1;
+        }
+    }
+
+    int retour;
+    if (moteur == MOTEUR_FLUX) {
+        retour = mainEnveloppeFlux(f);
+    } else if (moteur == MOTEUR_DYNAMIQUE) {
+        retour = mainEnveloppeDynamique(f);
+    } else if (moteur == MOTEUR_FENETRE) {
+        retour = mainEnveloppeFenetre(f, maxPoints, duree);
+    } else {
+        retour = mainEnveloppeFichier(f, moteur, nbThreads);
+    }
+    if (f != stdin) {
+        fclose(f);
+    }
+#ifdef COMPTEURS
+    exporteCompteurs(stderr);
+#endif
+    return retour;
+}
+
+int main(int argc, char *argv[]) {
     srand(time(NULL));
 
+    // Avec des arguments le calcul se fait sans fenêtre (fichier de points ou entrée standard)
+    if (argc > 1) {
+        return mainSansFenetre(argc, argv);
+    }
+
     // Pour quitter le programme l'utilisateur doit appuyer sur echap ou fermer la fenêtre
     while (1) {
         int dynamique = 0;  // Affichaque dynamique ou seulement rendu final
         int forme = 0;  // 0 : carré 1 : cercle
         int spiral = 0;  // Rayon de la forme qui grandit ou non
         int nbPoints = 0;  // Nombre de points de l'ensemble
+        int nbThreads = nombreCoeurs();  // Nombre de threads du calcul sans affichage dynamique
 
         MLV_create_window("Menu enveloppe convexe", "", 1000, 900);
         MLV_clear_window(MLV_rgba(30, 30, 30, 255));
@@ -829,9 +4234,9 @@ int main(void) {
             menu2(1000, 900, &nbPoints, &dynamique, &forme, &spiral);
             MLV_free_window();
             if (spiral) {
-                mainEnveloppeForme(250, 10, nbPoints, forme, spiral, dynamique);
+                mainEnveloppeForme(250, 10, nbPoints, nbThreads, forme, spiral, dynamique);
             } else {
-                mainEnveloppeForme(250, 230, nbPoints, forme, spiral, dynamique);
+                mainEnveloppeForme(250, 230, nbPoints, nbThreads, forme, spiral, dynamique);
             }
         }
     }
@@ -9,12 +9,19 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
 #include <MLV/MLV_all.h>
 #include <time.h>
 #include <math.h>
+#include <float.h>
 
 #define M_PI 3.14159265358979323846
+#define ERREUR_ORIENTATION ((3.0 + 8.0 * DBL_EPSILON) * DBL_EPSILON / 2)  // Borne d'erreur relative du calcul flottant de orientation
 #define BLOC 25
+#define BLOC_VERTEX 64  // Taille du premier bloc de Vertex d'une réserve
+#define BLOC_VERTEX_MAX 4096  // Taille maximale d'un bloc de Vertex
+#define SEUIL_FUSION 16  // Nombre de points entrant dans une couche à partir duquel ils y sont fusionnés d'un coup
 
 /**
  * @brief Coordonnées d'un point en 2 dimension
@@ -40,24 +47,70 @@ typedef struct {
  * 
  */
 typedef struct _vertex_ {
-    Point *p;  // Un point de l'ensemble
+    Point p;  // Coordonnées du sommet, copiées pour ne pas dépendre de l'ensemble
     struct _vertex_ *prec;  // Le vertex précédent
     struct _vertex_ *suiv;  // Le vertex suivant
 } Vertex, *Polygone;
 
 /**
- * @brief Cellule d'une liste **ListeEnveloppe** contenant un Polygone et 
+ * @brief Bloc de Vertex alloués en une seule fois par une ReserveVertex
+ * 
+ */
+typedef struct _bloc_vertex_ {
+    struct _bloc_vertex_ *suiv;  // Bloc alloué avant celui-ci
+    int taille;  // Nombre de cellules du bloc
+    int nbDistribues;  // Nombre de cellules déjà distribuées
+    Vertex cellules[];  // Cellules contiguës en mémoire
+} BlocVertex;
+
+/**
+ * @brief Réserve de Vertex d'une enveloppe : les cellules sont découpées dans 
+ * des blocs et celles qui sont libérées sont réutilisées en priorité
+ * 
+ */
+typedef struct {
+    BlocVertex *blocs;  // Liste des blocs alloués, le plus récent en tête
+    Vertex *libres;  // Cellules libérées, chaînées par leur champ suiv
+} ReserveVertex;
+
+/**
+ * @brief Couche d'un répertoire **ListeEnveloppes** contenant un Polygone et 
  *        plusieurs renseignements utiles (longeur courent, longueur maximal, longueur moyenne)
  * 
  */
-typedef struct _convex_ {
+typedef struct {
     Polygone p;  // Polygône représentant l'enveloppe convexe
     int curlen;  // Nombre de points du polygône
     int maxlen;  // Nombre de points maximale du polygône
     float avg;   // Nombre de points moyen du polynôme
     int nbMaj;  // Nombre de mise à jour de l'enveloppe
-    struct _convex_ *suiv;  // Enveloppe convex contenue dans celle-ci
-} ConvexHull, *ListeEnveloppes;
+    int nbRejets;  // Nombre de points rejetés par l'octogone des points extrêmes sans parcourir le polygône
+    Point extremes[8];  // Points extrêmes dans 8 directions, sommets d'un octogone contenu dans l'enveloppe
+    ReserveVertex reserve;  // Réserve dans laquelle sont pris les Vertex du polygône
+    Ensemble entrants;  // Points en attente d'être ajoutés à cette enveloppe, rejetés par l'enveloppe précédente
+} ConvexHull;
+
+/**
+ * @brief Répertoire des enveloppes emboitées, rangées dans un tableau de la plus extérieure 
+ * à la plus intérieure : la couche k est contenue dans la couche k - 1
+ * 
+ */
+typedef struct {
+    ConvexHull **couches;  // Tableau des couches, les cellules ne sont pas déplacées quand il est réalloué
+    int nbCouches;  // Nombre de couches
+    int maxLen;  // Taille du tableau
+} ListeEnveloppes;
+
+/**
+ * @brief Copie en tableaux des sommets de toutes les couches d'un ListeEnveloppes, pour 
+ * trouver la profondeur d'un point par recherches dichotomiques sans l'ajouter
+ * 
+ */
+typedef struct {
+    Point *sommets;  // Sommets de chaque couche dans le sens direct, couche après couche
+    int *debuts;  // debuts[k] : position du premier sommet de la couche k, debuts[nbCouches] : nombre de sommets
+    int nbCouches;  // Nombre de couches
+} IndexProfondeur;
 
 // --------------------Fonction de manipulations des points--------------------
 
@@ -73,18 +126,95 @@ void printListePoint(Point *p, int lenP) {
     }
 }
 
+// ----------------Fonctions de gestion des réserves de Vertex-----------------
+
+/**
+ * @brief Initialise et renvoie une réserve de Vertex vide
+ * 
+ * @return ReserveVertex Réserve initialisée
+ */
+ReserveVertex initReserveVertex(void) {
+    ReserveVertex r;
+    r.blocs = NULL;
+    r.libres = NULL;
+    return r;
+}
+
+/**
+ * @brief Ajoute un bloc de cellules à la réserve **r**, chaque bloc est deux fois 
+ * plus grand que le précédent jusqu'à **BLOC_VERTEX_MAX** cellules
+ * 
+ * @param r Réserve à agrandir
+ * @return int 1 : l'allocation du bloc a réussi \n
+ *             0 : l'allocation du bloc a échoué
+ */
+int ajouteBlocVertex(ReserveVertex *r) {
+    int taille = BLOC_VERTEX;
+    if (r->blocs) {
+        taille = 2 * r->blocs->taille;
+        if (taille > BLOC_VERTEX_MAX) {
+            taille = BLOC_VERTEX_MAX;
+        }
+    }
+
+    BlocVertex *bloc = (BlocVertex*)malloc(sizeof(BlocVertex) + taille * sizeof(Vertex));
+    if (!bloc) {
+        return 0;
+    }
+    bloc->taille = taille;
+    bloc->nbDistribues = 0;
+    bloc->suiv = r->blocs;
+    r->blocs = bloc;
+    return 1;
+}
+
+/**
+ * @brief Rend la cellule **v** à la réserve **r** pour qu'elle soit réutilisée
+ * 
+ * @param r Réserve d'où provient la cellule
+ * @param v Cellule rendue
+ */
+void rendVertex(ReserveVertex *r, Vertex *v) {
+    v->suiv = r->libres;
+    r->libres = v;
+}
+
+/**
+ * @brief Libére en une seule fois tous les blocs de la réserve **r**, 
+ * toutes les cellules qui en proviennent deviennent invalides
+ * 
+ * @param r Réserve à vider
+ */
+void libereReserveVertex(ReserveVertex *r) {
+    BlocVertex *tmp;
+    while (r->blocs) {
+        tmp = r->blocs->suiv;
+        free(r->blocs);
+        r->blocs = tmp;
+    }
+    r->libres = NULL;
+}
+
 // ---------------------Fonctions de gestion des Polygones---------------------
 
 /**
- * @brief Alloue et renvoie un pointeur sur une zone mémoire pour un Vertex
+ * @brief Prend une cellule Vertex dans la réserve **r**, une cellule libérée est 
+ * réutilisée en priorité, sinon elle est découpée dans le bloc le plus récent
  * 
- * @param p Addresse du point contenue dans le vertex
+ * @param r Réserve dans laquelle la cellule est prise
+ * @param p Point copié dans le vertex
  * @return Vertex* zone mémoire alloué
  */
-Vertex* allocCellVertex(Point *p) {
-    Vertex *cell = (Vertex*)malloc(sizeof(Vertex));
-    if (!cell) {
-        return cell;
+Vertex* allocCellVertex(ReserveVertex *r, Point p) {
+    Vertex *cell = r->libres;
+    if (cell) {
+        r->libres = cell->suiv;
+    } else {
+        if ((!r->blocs || r->blocs->nbDistribues == r->blocs->taille) && !ajouteBlocVertex(r)) {
+            return NULL;
+        }
+        cell = &(r->blocs->cellules[r->blocs->nbDistribues]);
+        r->blocs->nbDistribues++;
     }
     cell->p = p;
     cell->suiv = NULL;
@@ -96,12 +226,13 @@ Vertex* allocCellVertex(Point *p) {
  * @brief Ajoute un vertex de point **p** en tant que premier point du polygone **Poly**
  * 
  * @param poly Polygône modifié
+ * @param r Réserve dans laquelle le Vertex est pris
  * @param p Point ajouté
  * @return int 1 : l'allocation d'un Vertex a réussi \n
  *             0 : l'allocation d'un Vertex a échoué 
  */
-int ajouteVertexPolygone(Polygone *poly, Point *p) {
-    Vertex* cell = allocCellVertex(p);
+int ajouteVertexPolygone(Polygone *poly, ReserveVertex *r, Point p) {
+    Vertex* cell = allocCellVertex(r, p);
     if (!cell) {
         printf("\nEchec de l'allocation de mémoire pour un Vertex\n");
         return 0;
@@ -148,21 +279,22 @@ void supprimeVertexPolygone(Vertex *v, Polygone *poly) {
  * 
  * @param v Vertex à libérer
  * @param poly Polygône contenant le Vertex
+ * @param r Réserve d'où provient le Vertex
  */
-void freeVertex(Vertex *v, Polygone *poly) {
+void freeVertex(Vertex *v, Polygone *poly, ReserveVertex *r) {
     supprimeVertexPolygone(v, poly);
-    free(v);
+    rendVertex(r, v);
 }
 
 /**
- * @brief Libére l'espace alloué par un polygone
+ * @brief Libére l'espace alloué par un polygone en rendant d'un coup tous les blocs de sa réserve
  * 
  * @param Poly 
+ * @param r Réserve d'où proviennent tous les Vertex du polygone et uniquement de ce polygone
  */
-void freePolygone(Polygone *Poly) {
-    while (*Poly) {
-        freeVertex(*Poly, Poly);
-    }
+void freePolygone(Polygone *Poly, ReserveVertex *r) {
+    libereReserveVertex(r);
+    *Poly = NULL;
 }
 
 /**
@@ -176,10 +308,10 @@ void printPolygone(Polygone poly) {
     }
 
     Vertex* tete = poly;
-    printf("%f %f\n", poly->p->x, poly->p->y);
+    printf("%f %f\n", poly->p.x, poly->p.y);
     poly = poly->suiv;
     for (; poly != tete; poly = poly->suiv) {
-        printf("%f %f\n", poly->p->x, poly->p->y);
+        printf("%f %f\n", poly->p.x, poly->p.y);
     }
 }
 
@@ -201,20 +333,73 @@ Ensemble initEnsemble(Point* tabPoints, int lenTabPoints) {
 }
 
 /**
- * @brief Réallour la mémoire pour un tableau de point pour ajouter **bloc** places
+ * @brief Réalloue le tableau de points de **e** pour qu'il contienne **taille** places \n
+ * En cas d'échec l'ancien tableau reste valide et inchangé
  * 
- * @param tabPoints Tableau à réallouer
+ * @param e Ensemble dont le tableau est réalloué
+ * @param taille Nouvelle taille du tableau, au moins égale à e->nbPoints
  * @return int 0 : Echec de la réallocation \n
  *             1 : Réussit de la réallocation
  */
+int redimensionneTabPoint(Ensemble *e, int taille) {
+    Point *tabPoints = (Point*)realloc(e->tabPoints, sizeof(Point) * (size_t)taille);
+    if (!tabPoints) {
+        return 0;
+    }
+    e->tabPoints = tabPoints;
+    e->maxLen = taille;
+    return 1;
+}
+
+/**
+ * @brief Agrandit le tableau de points de **e** en doublant sa taille (au moins **BLOC** places) \n
+ * La croissance géométrique rend l'ajout d'un point en O(1) amorti
+ * 
+ * @param e Ensemble dont le tableau est réalloué
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
 int reAllocTabPoint(Ensemble *e) {
-    e->tabPoints = (Point*)realloc(e->tabPoints, sizeof(Point) * (e->maxLen +  BLOC));
-    if (e->tabPoints) {
-        e->maxLen += BLOC;
+    int taille = BLOC;
+    if (e->maxLen >= INT_MAX / 2) {
+        taille = INT_MAX;
+    } else if (e->maxLen >= BLOC) {
+        taille = 2 * e->maxLen;
+    }
+    if (taille <= e->maxLen) {
+        return 0;
+    }
+    return redimensionneTabPoint(e, taille);
+}
+
+/**
+ * @brief Réserve de la place pour au moins **taille** points dans **e**, 
+ * utile pour dimensionner le tableau une seule fois avant un ajout massif
+ * 
+ * @param e Ensemble à agrandir
+ * @param taille Nombre de places voulues
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
+int reserveEnsemble(Ensemble *e, int taille) {
+    if (taille <= e->maxLen) {
         return 1;
     }
-    free(e->tabPoints);
-    return 0;
+    return redimensionneTabPoint(e, taille);
+}
+
+/**
+ * @brief Réduit le tableau de points de **e** à son nombre de points pour libérer la place inutilisée
+ * 
+ * @param e Ensemble à ajuster
+ * @return int 0 : Echec de la réallocation, l'ancien tableau reste valide \n
+ *             1 : Réussit de la réallocation
+ */
+int ajusteEnsemble(Ensemble *e) {
+    if (e->nbPoints == e->maxLen || !e->nbPoints) {
+        return 1;
+    }
+    return redimensionneTabPoint(e, e->nbPoints);
 }
 
 /**
@@ -237,6 +422,27 @@ int ajoutePointEnsemble(Ensemble *e, Point p) {
     return 1;
 }
 
+/**
+ * @brief Ajoute à l'ensemble **e** les points lus dans **f** (deux coordonnées par ligne)
+ * 
+ * @param f Fichier lu jusqu'à sa fin ou jusqu'à la première ligne mal formée
+ * @param e Ensemble à compléter
+ * @return int 0 : Echec de la réallocation \n
+ *             1 : Réussit de la lecture
+ */
+int lectureEnsemble(FILE *f, Ensemble *e) {
+    Point p;
+    while (fscanf(f, "%lf %lf", &p.x, &p.y) == 2) {
+        if (!ajoutePointEnsemble(e, p)) {
+            return 0;
+        }
+    }
+    if (!feof(f)) {
+        fprintf(stderr, "Lecture interrompue après %d points : ligne mal formée\n", e->nbPoints);
+    }
+    return 1;
+}
+
 /**
  * @brief Affiche les coordonnées des points de l'ensemble ainsi que ses informations
  * 
@@ -265,38 +471,67 @@ ConvexHull initConvexHull(void) {
     c.curlen = 0;
     c.maxlen = 0;
     c.nbMaj = 0;
-    c.suiv = NULL;
+    c.nbRejets = 0;
+    c.reserve = initReserveVertex();
+    c.entrants = initEnsemble(NULL, 0);
     return c;
 }
 
 /**
- * @brief Initialise et alloue la mémoire nécessaire pour une cellule ConvexHull
+ * @brief Initialise et renvoie un répertoire d'enveloppes vide
  * 
- * @return ConvexHull* 
+ * @return ListeEnveloppes Répertoire initialisé
  */
-ConvexHull* allocEnveloppeConvex(void) {
+ListeEnveloppes initListeEnveloppes(void) {
+    ListeEnveloppes l;
+    l.couches = NULL;
+    l.nbCouches = 0;
+    l.maxLen = 0;
+    return l;
+}
+
+/**
+ * @brief Initialise et alloue la mémoire nécessaire pour une cellule ConvexHull, 
+ * rangée comme nouvelle couche la plus intérieure de **l** \n
+ * Le tableau des couches double de taille quand il est plein
+ * 
+ * @param l Répertoire agrandi
+ * @return ConvexHull* Nouvelle couche, NULL si une allocation a échoué
+ */
+ConvexHull* allocEnveloppeConvex(ListeEnveloppes *l) {
+    if (l->nbCouches == l->maxLen) {
+        int taille = (l->maxLen < BLOC) ? BLOC : 2 * l->maxLen;
+        ConvexHull **couches = (ConvexHull**)realloc(l->couches, sizeof(ConvexHull*) * taille);
+        if (!couches) {
+            return NULL;
+        }
+        l->couches = couches;
+        l->maxLen = taille;
+    }
+
     ConvexHull* c = (ConvexHull*)malloc(sizeof(ConvexHull));
     if (!c) {
         return c;
     }
 
     *c = initConvexHull();
+    l->couches[l->nbCouches++] = c;
     return c;
 }
 
 /**
- * @brief Libére la mémoire allouer pour une liste d'enveloppe convex **l**
+ * @brief Libére la mémoire allouer pour un répertoire d'enveloppes convexes **l**, qui redevient vide
  * 
  * @param l 
  */
 void freeListeEnveloppeConvex(ListeEnveloppes *l) {
-    ConvexHull* tmp = *l;
-    while (*l) {
-        tmp = (*l)->suiv;
-        freePolygone(&((*l)->p));
-        free(*l);
-        *l = tmp;
+    for (int k = 0; k < l->nbCouches; ++k) {
+        freePolygone(&(l->couches[k]->p), &(l->couches[k]->reserve));
+        free(l->couches[k]->entrants.tabPoints);
+        free(l->couches[k]);
     }
+    free(l->couches);
+    *l = initListeEnveloppes();
 }
 
 /**
@@ -316,21 +551,163 @@ void majConvexHull(ConvexHull* env_convex) {
 }
 
 /**
- * @brief Renvoie la longueur de la liste **lst**
+ * @brief Affiche les informations de l'enveloppe **env_convex**
+ * 
+ * @param env_convex 
+ */
+void printInfoConvexHull(ConvexHull env_convex) {
+    printf("ENVELOPPE CONVEXE INFO :\n");
+    printf("    curlen = %d \n", env_convex.curlen);
+    printf("    maxlen = %d \n", env_convex.maxlen);
+    printf("    avg = %f \n", env_convex.avg);
+    printf("    nbMaj = %d \n", env_convex.nbMaj);
+    printf("    nbRejets = %d \n", env_convex.nbRejets);
+    printf("\n");
+}
+
+/**
+ * @brief Renvoie le nombre de couches de **lst** en O(1)
  * 
  * @param lst 
- * @return int longueur de **lst**
+ * @return int nombre de couches de **lst**
  */
 int lenListeConvexHull(ListeEnveloppes lst) {
-    int cmpt = 0;
-    for (; lst; lst = lst->suiv) {
-        cmpt++;
+    return lst.nbCouches;
+}
+
+/**
+ * @brief Renvoie directement la couche de profondeur **k** de **lst**
+ * 
+ * @param lst 
+ * @param k Profondeur de la couche, 0 pour l'enveloppe de tous les points
+ * @return ConvexHull* Couche demandée, NULL si **lst** a moins de **k** + 1 couches
+ */
+ConvexHull* coucheListeEnveloppes(ListeEnveloppes *lst, int k) {
+    if (k < 0 || k >= lst->nbCouches) {
+        return NULL;
     }
-    return cmpt;
+    return lst->couches[k];
 }
 
 // ----------------Algorithme d'ajout de points dans l'ensemble----------------
 
+/**
+ * @brief Calcule **a** + **b** et l'erreur d'arrondi de cette somme, de sorte que 
+ * **somme** + **erreur** = **a** + **b** exactement
+ * 
+ * @param a 
+ * @param b 
+ * @param somme Somme arrondie
+ * @param erreur Erreur d'arrondi
+ */
+void sommeExacte(double a, double b, double *somme, double *erreur) {
+    double s = a + b;
+    double bVirtuel = s - a;
+    double aVirtuel = s - bVirtuel;
+    *erreur = (a - aVirtuel) + (b - bVirtuel);
+    *somme = s;
+}
+
+/**
+ * @brief Calcule **a** * **b** et l'erreur d'arrondi de ce produit, de sorte que 
+ * **produit** + **erreur** = **a** * **b** exactement
+ * 
+ * @param a 
+ * @param b 
+ * @param produit Produit arrondi
+ * @param erreur Erreur d'arrondi
+ */
+void produitExact(double a, double b, double *produit, double *erreur) {
+    *produit = a * b;
+    *erreur = fma(a, b, -*produit);
+}
+
+/**
+ * @brief Ajoute **b** à l'expansion **e** (somme de doubles sans chevauchement, par magnitude croissante), 
+ * les composantes nulles sont éliminées
+ * 
+ * @param e Expansion à agrandir, de taille au moins **len** + 1
+ * @param len Nombre de composantes de **e**
+ * @param b Double à ajouter
+ * @return int Nouveau nombre de composantes de **e**
+ */
+int ajouteExpansion(double *e, int len, double b) {
+    int nouvLen = 0;
+    double q = b;
+    for (int k = 0; k < len; ++k) {
+        double erreur;
+        sommeExacte(q, e[k], &q, &erreur);
+        if (erreur != 0) {
+            e[nouvLen++] = erreur;
+        }
+    }
+    if (q != 0) {
+        e[nouvLen++] = q;
+    }
+    return nouvLen;
+}
+
+/**
+ * @brief Calcule exactement le signe du déterminant d'orientation de **a** **b** **c**, 
+ * chacun des six produits est décomposé sans erreur et sommé dans une expansion
+ * 
+ * @param a 
+ * @param b 
+ * @param c 
+ * @return double Du signe de l'orientation dans un repère d'ordonnées vers le haut
+ */
+double orientationExacte(Point a, Point b, Point c) {
+    double termes[6][2] = {{a.x, b.y}, {-a.y, b.x}, {b.x, c.y}, {-b.y, c.x}, {c.x, a.y}, {-c.y, a.x}};
+    double e[12];
+    int len = 0;
+    for (int k = 0; k < 6; ++k) {
+        double produit, erreur;
+        produitExact(termes[k][0], termes[k][1], &produit, &erreur);
+        len = ajouteExpansion(e, len, erreur);
+        len = ajouteExpansion(e, len, produit);
+    }
+    // La composante de plus grande magnitude donne le signe de l'expansion
+    return len ? e[len - 1] : 0;
+}
+
+/**
+ * @brief Calcule le déterminant d'orientation de **a** **b** **c** avec un signe toujours exact : 
+ * le calcul flottant est gardé si sa borne d'erreur le permet, sinon on passe à orientationExacte
+ * 
+ * @param a 
+ * @param b 
+ * @param c 
+ * @return double > 0 : **a** **b** **c** tournent dans le sens trigonométrique (ordonnées vers le haut) \n
+ *                0 : **a** **b** **c** sont alignés \n
+ *              < 0 : **a** **b** **c** tournent dans le sens horaire
+ */
+double orientation(Point a, Point b, Point c) {
+    double gauche = (a.x - c.x) * (b.y - c.y);
+    double droite = (a.y - c.y) * (b.x - c.x);
+    double det = gauche - droite;
+    double somme;
+
+    // Si les deux produits sont de signes opposés la soustraction ne peut pas changer le signe
+    if (gauche > 0) {
+        if (droite <= 0) {
+            return det;
+        }
+        somme = gauche + droite;
+    } else if (gauche < 0) {
+        if (droite >= 0) {
+            return det;
+        }
+        somme = -gauche - droite;
+    } else {
+        return det;
+    }
+
+    if (det >= ERREUR_ORIENTATION * somme || -det >= ERREUR_ORIENTATION * somme) {
+        return det;
+    }
+    return orientationExacte(a, b, c);
+}
+
 /**
  * @brief Détérmine si un triangle formé de **a** **b** et **c** est directe selon le sens trigonométrique
  * 
@@ -341,24 +718,173 @@ int lenListeConvexHull(ListeEnveloppes lst) {
  *             0 : Le triangle est indirecte
  */
 int triangleDirecte(Point a, Point b, Point c) {
-    // Comme notre axe des ordonnées n'a pas la même orientation, on change le signe des ordonnées dans la formule
-    double scalaire = ((b.x - a.x) * ((-c.y) - (-a.y))) - ((c.x - a.x) * ((-b.y) - (-a.y)));
-    if (scalaire >= 0) {
+    // Comme notre axe des ordonnées n'a pas la même orientation, le sens trigonométrique à l'écran est le sens horaire de orientation
+    if (orientation(a, b, c) <= 0) {
         return 1;
     }
     return 0;
 }
 
 /**
- * @brief Regarde si le point p est dans l'enveloppe ou non et la modifie en concéquence
+ * @brief Compare deux points selon l'ordre lexicographique (x puis y)
+ * 
+ * @param a 
+ * @param b 
+ * @return int -1 : **a** est avant **b** \n
+ *             0 : **a** et **b** sont confondus \n
+ *             1 : **a** est après **b**
+ */
+int ordrePoints(Point a, Point b) {
+    if (a.x != b.x) {
+        return (a.x < b.x) ? -1 : 1;
+    }
+    if (a.y != b.y) {
+        return (a.y < b.y) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Traite l'ajout de **p** à une enveloppe réduite au segment [**a**, **b**] : si les trois points 
+ * sont alignés, l'extrémité dépassée par **p** est échangée avec **p**
+ * 
+ * @param a Première extrémité du segment
+ * @param b Seconde extrémité du segment
+ * @param p Point ajouté, contient en sortie le point qui n'est plus une extrémité
+ * @return int 1 : **p** est aligné avec **a** et **b**, le segment est à jour \n
+ *             0 : **p** n'est pas aligné, il forme un triangle avec **a** et **b**
+ */
+int prolongeSegment(Point *a, Point *b, Point *p) {
+    if (orientation(*a, *b, *p) != 0) {
+        return 0;
+    }
+    Point *min = (ordrePoints(*a, *b) <= 0) ? a : b;
+    Point *max = (min == a) ? b : a;
+    Point tmp = *p;
+    if (ordrePoints(*p, *min) < 0) {
+        *p = *min;
+        *min = tmp;
+    } else if (ordrePoints(*p, *max) > 0) {
+        *p = *max;
+        *max = tmp;
+    }
+    return 1;
+}
+
+/**
+ * @brief Met à jour les huit points extrêmes **extremes** avec le point **p**
+ * 
+ * @param extremes Tableau de huit points extrêmes déjà initialisé
+ * @param p Point ajouté
+ */
+void majExtremes(Point *extremes, Point p) {
+    // Directions dans l'ordre trigonométrique
+    static const int dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static const int dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    for (int k = 0; k < 8; ++k) {
+        if (dx[k] * p.x + dy[k] * p.y > dx[k] * extremes[k].x + dy[k] * extremes[k].y) {
+            extremes[k] = p;
+        }
+    }
+}
+
+/**
+ * @brief Met à jour les points extrêmes de **env_convex** dans les 8 directions multiples de 45° avec le point **p** \n
+ * Le premier point de l'enveloppe est extrême dans toutes les directions
  * 
  * @param env_convex Enveloppe à mettre à jour
+ * @param p Point ajouté à l'enveloppe
+ */
+void majExtremesConvexHull(ConvexHull *env_convex, Point p) {
+    if (!env_convex->nbMaj) {
+        for (int k = 0; k < 8; ++k) {
+            env_convex->extremes[k] = p;
+        }
+        return;
+    }
+    majExtremes(env_convex->extremes, p);
+}
+
+/**
+ * @brief Détermine si **p** est strictement à l'intérieur de l'octogone des points extrêmes de 
+ * **env_convex**, les points extrêmes étant dans l'enveloppe **p** l'est aussi (filtre d'Akl-Toussaint)
+ * 
+ * @param env_convex Enveloppe contenant au moins un point
  * @param p Point à vérifier
+ * @return int 1 : **p** est strictement dans l'octogone \n
+ *             0 : **p** est sur le bord ou à l'extérieur de l'octogone
+ */
+int dansOctogoneConvexHull(ConvexHull *env_convex, Point p) {
+    Point *e = env_convex->extremes;
+    int nbCotes = 0;
+    for (int k = 0; k < 8; ++k) {
+        Point *suiv = &(e[(k + 1) % 8]);
+        if (e[k].x == suiv->x && e[k].y == suiv->y) {
+            continue;
+        }
+        // L'octogone est parcouru dans le sens inverse d'un polygône direct
+        if (triangleDirecte(e[k], *suiv, p)) {
+            return 0;
+        }
+        nbCotes++;
+    }
+    return nbCotes > 0;
+}
+
+/**
+ * @brief Place **p** parmi les points en attente de la couche **rang** + 1 de **lst**, 
+ * qui est créée si besoin
+ * 
+ * @param lst Répertoire des enveloppes
+ * @param rang Profondeur de la couche qui rejette **p**
+ * @param p Point rejeté
  */
-void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
+void passeCoucheSuivante(ListeEnveloppes *lst, int rang, Point p) {
+    ConvexHull *suiv = coucheListeEnveloppes(lst, rang + 1);
+    if (!suiv) {  // Si il n'y a pas d'enveloppe convexe on en crée une nouvelle
+        suiv = allocEnveloppeConvex(lst);
+    }
+    if (!suiv || !ajoutePointEnsemble(&(suiv->entrants), p)) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+}
+
+/**
+ * @brief Regarde si le point p est dans l'enveloppe ou non et la modifie en concéquence, sans toucher 
+ * aux sous enveloppes : les points qui n'en sont pas des sommets sont mis en attente dans l'enveloppe suivante
+ * 
+ * @param lst Répertoire des enveloppes
+ * @param rang Profondeur de l'enveloppe à mettre à jour
+ * @param p Point à vérifier, copié dans l'enveloppe s'il en devient un sommet
+ */
+void ajoutePointCouche(ListeEnveloppes *lst, int rang, Point p) {
+    ConvexHull *env_convex = lst->couches[rang];
+
+    // Un point dans l'octogone des points extrêmes est dans l'enveloppe, il passe directement aux sous enveloppes
+    if (env_convex->curlen >= 3 && dansOctogoneConvexHull(env_convex, p)) {
+        env_convex->nbRejets++;
+
+        passeCoucheSuivante(lst, rang, p);
+
+        majConvexHull(env_convex);
+        return;
+    }
+    majExtremesConvexHull(env_convex, p);
+
+    // Un point confondu avec l'unique sommet, ou aligné avec le segment et entre ses extrémités, 
+    // passe aux sous enveloppes, une extrémité dépassée par p y passe à sa place
+    if ((env_convex->curlen == 1 && ordrePoints(p, env_convex->p->p) == 0) || 
+        (env_convex->curlen == 2 && prolongeSegment(&(env_convex->p->p), &(env_convex->p->suiv->p), &p))) {
+        passeCoucheSuivante(lst, rang, p);
+
+        majConvexHull(env_convex);
+        return;
+    }
+
     // Si il y a moins de 2 points dans env_convex on ajoute p à l'enveloppe
     if (env_convex->curlen < 2) {
-        if (!ajouteVertexPolygone(&(env_convex->p), p)) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
             printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
             exit(1);
         }
@@ -370,12 +896,12 @@ void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
     // Orientation du premier triangle
     if (env_convex->curlen == 2) {
         // Si les trois premiers points forment un triangle indirecte, on reforme la liste pour avoir un direct
-        if (!ajouteVertexPolygone(&(env_convex->p), p)) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
             printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
             exit(1);
         }
-        if (!triangleDirecte(*(env_convex->p->p), *(env_convex->p->suiv->p), *(env_convex->p->prec->p))) {
-            Point *tmp = env_convex->p->suiv->p;
+        if (!triangleDirecte(env_convex->p->p, env_convex->p->suiv->p, env_convex->p->prec->p)) {
+            Point tmp = env_convex->p->suiv->p;
             env_convex->p->suiv->p = env_convex->p->prec->p;
             env_convex->p->prec->p = tmp;
         }
@@ -389,16 +915,11 @@ void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
     do {
         s_i = s_j;
         s_j = s_j->suiv;
-    } while (triangleDirecte(*p, *(s_i->p), *(s_j->p)) && s_i != env_convex->p);  // Tant que le triangle est directe est qu'on a pas vérifier tous les points
+    } while (triangleDirecte(p, s_i->p, s_j->p) && s_i != env_convex->p);  // Tant que le triangle est directe est qu'on a pas vérifier tous les points
 
     // Si on est sortit de la boucle car tous les triangles sont directes, on met à jour les sous enveloppes
-    if (triangleDirecte(*p, *(s_i->p), *(s_j->p)) && s_i == env_convex->p) {
-    
-        if (!env_convex->suiv) {  // Si il n'y a pas d'enveloppe convexe on en crée une nouvelle
-            env_convex->suiv = allocEnveloppeConvex();
-        }
-
-        majEnveloppeConvex(env_convex->suiv, p);  // Démarre une récursivité en mettant à jours les sous enveloppes
+    if (triangleDirecte(p, s_i->p, s_j->p) && s_i == env_convex->p) {
+        passeCoucheSuivante(lst, rang, p);
 
         majConvexHull(env_convex);
         return;
@@ -407,22 +928,19 @@ void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
     // si on à un triangle indirecte
     // On insére p en tant que nouvelle tête de liste entre s_i et s_j
     env_convex->p = s_j;
-    if (!ajouteVertexPolygone(&(env_convex->p), p)) {
+    if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), p)) {
         printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
         exit(1);
     }
     env_convex->curlen++;
     
-    // Nettoyage avant
+    // Nettoyage avant, un sommet aligné avec ses voisins est retiré comme avec chaineMonotone : 
+    // les couches ne dépendent ni de l'ordre des ajouts ni de SEUIL_FUSION
     s_i = env_convex->p->suiv;
     s_j = s_i->suiv;
-    while (!triangleDirecte(*(env_convex->p->p), *(s_i->p), *(s_j->p))) {
-        if (!env_convex->suiv) {  // Si il n'y a pas d'enveloppe convexe on en crée une nouvelle
-            env_convex->suiv = allocEnveloppeConvex();
-        }
-        majEnveloppeConvex(env_convex->suiv, s_i->p);  // Démarre une récursivité en mettant à jours les sous enveloppes
-        
-        freeVertex(s_i, &(env_convex->p));
+    while (orientation(env_convex->p->p, s_i->p, s_j->p) >= 0) {
+        passeCoucheSuivante(lst, rang, s_i->p);
+        freeVertex(s_i, &(env_convex->p), &(env_convex->reserve));
         s_i = env_convex->p->suiv;
         s_j = s_i->suiv;
         env_convex->curlen--;
@@ -431,13 +949,9 @@ void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
     // Nettoyage arrière
     s_i = env_convex->p->prec->prec;
     s_j = env_convex->p->prec;
-    while (!triangleDirecte(*(env_convex->p->p), *(s_i->p), *(s_j->p))) {
-        if (!env_convex->suiv) {  // Si il n'y a pas d'enveloppe convexe on en crée une nouvelle
-            env_convex->suiv = allocEnveloppeConvex();
-        }
-        majEnveloppeConvex(env_convex->suiv, s_j->p);  // Démarre une récursivité en mettant à jours les sous enveloppes
-
-        freeVertex(s_j, &(env_convex->p));
+    while (orientation(env_convex->p->p, s_i->p, s_j->p) >= 0) {
+        passeCoucheSuivante(lst, rang, s_j->p);
+        freeVertex(s_j, &(env_convex->p), &(env_convex->reserve));
         s_i = env_convex->p->prec->prec;
         s_j = env_convex->p->prec;
         env_convex->curlen--;
@@ -445,6 +959,376 @@ void majEnveloppeConvex(ConvexHull *env_convex, Point *p) {
     majConvexHull(env_convex);
 }
 
+// -------Algorithme de calcul des enveloppes emboitées en une seule fois------
+
+/**
+ * @brief Compare deux adresses de points selon l'ordre lexicographique (x puis y), utilisé par qsort
+ *
+ * @param a Adresse d'un Point*
+ * @param b Adresse d'un Point*
+ * @return int < 0 : **a** est avant **b** \n
+ *             0 : **a** et **b** sont confondus \n
+ *             > 0 : **a** est après **b**
+ */
+int comparePoints(const void *a, const void *b) {
+    return ordrePoints(**(Point * const *)a, **(Point * const *)b);
+}
+
+/**
+ * @brief Calcule avec la chaîne monotone d'Andrew l'enveloppe des **n** points de **tri**, 
+ * déjà triés dans l'ordre lexicographique, sans les déplacer
+ *
+ * @param tri Points triés
+ * @param n Nombre de points
+ * @param chaine Tableau d'au moins 2 * **n** places, reçoit les indices dans **tri** des sommets 
+ *               dans l'ordre de parcours, chaque sommet n'y apparaît qu'une fois
+ * @return int Nombre de sommets de l'enveloppe
+ */
+int chaineMonotone(Point **tri, int n, int *chaine) {
+    int k;
+    int lenChaine = 0;
+
+    // Des points tous confondus forment une enveloppe d'un seul sommet
+    if (n == 0 || ordrePoints(*tri[0], *tri[n - 1]) == 0) {
+        chaine[0] = 0;
+        return n > 0;
+    }
+    if (n == 2) {
+        chaine[0] = 0;
+        chaine[1] = 1;
+        return 2;
+    }
+
+    // Chaîne inférieure, on retire le dernier sommet tant qu'il ne forme pas un virage strict
+    for (k = 0; k < n; ++k) {
+        while (lenChaine >= 2 && triangleDirecte(*tri[chaine[lenChaine - 2]], *tri[chaine[lenChaine - 1]], *tri[k])) {
+            lenChaine--;
+        }
+        chaine[lenChaine++] = k;
+    }
+    // Chaîne supérieure, le dernier point ajouté est le premier de la chaîne inférieure
+    int debutSup = lenChaine + 1;
+    for (k = n - 2; k >= 0; --k) {
+        while (lenChaine >= debutSup && triangleDirecte(*tri[chaine[lenChaine - 2]], *tri[chaine[lenChaine - 1]], *tri[k])) {
+            lenChaine--;
+        }
+        chaine[lenChaine++] = k;
+    }
+    return lenChaine - 1;
+}
+
+/**
+ * @brief Calcule en une seule fois les enveloppes convexes emboitées de tous les points de **e** 
+ * par pelures successives et remplace la liste **lst** \n
+ * Les points ne sont triés qu'une fois : chaque couche est une chaîne monotone sur les points restants, 
+ * dont on retire ensuite les sommets sans changer leur ordre, une couche coûte donc O(n) \n
+ * Les couches sont les mêmes qu'avec des ajouts successifs par majEnveloppeConvex, points alignés ou confondus compris : 
+ * dans les deux cas un point sur le bord d'une couche sans en être un sommet passe à la couche suivante
+ *
+ * @param lst Liste remplacée, les polygônes sont orientés comme avec majEnveloppeConvex
+ * @param e Ensemble de points dont on calcule les enveloppes
+ * @return int 1 : Le calcul a réussi \n
+ *             0 : Echec d'une allocation de mémoire
+ */
+int peleEnveloppesEnsemble(ListeEnveloppes *lst, Ensemble e) {
+    int k;
+    int n = e.nbPoints;
+
+    freeListeEnveloppeConvex(lst);
+    Point **tri = (Point**)malloc(sizeof(Point*) * (n + 1));
+    int *chaine = (int*)malloc(sizeof(int) * (2 * n + 1));  // Indices dans tri des sommets de la couche
+    char *sommet = (char*)calloc(n + 1, sizeof(char));  // Marque les points de tri qui sont des sommets de la couche
+    if (!tri || !chaine || !sommet) {
+        free(tri);
+        free(chaine);
+        free(sommet);
+        return 0;
+    }
+
+    for (k = 0; k < n; ++k) {
+        tri[k] = &(e.tabPoints[k]);
+    }
+    qsort(tri, n, sizeof(Point*), comparePoints);
+
+    while (n > 0) {
+        ConvexHull *couche = allocEnveloppeConvex(lst);
+        if (!couche) {
+            free(tri);
+            free(chaine);
+            free(sommet);
+            return 0;
+        }
+        int lenChaine = chaineMonotone(tri, n, chaine);
+
+        // ajouteVertexPolygone insère en tête, la chaîne est donc parcourue dans le sens direct une fois insérée
+        for (k = 0; k < lenChaine; ++k) {
+            if (!ajouteVertexPolygone(&(couche->p), &(couche->reserve), *tri[chaine[k]])) {
+                free(tri);
+                free(chaine);
+                free(sommet);
+                return 0;
+            }
+            if (!k) {
+                majExtremesConvexHull(couche, *tri[chaine[k]]);
+            } else {
+                majExtremes(couche->extremes, *tri[chaine[k]]);
+            }
+            sommet[chaine[k]] = 1;
+        }
+        couche->curlen = lenChaine;
+        majConvexHull(couche);
+
+        // Les points restants gardent leur ordre, ils sont déjà triés pour la couche suivante
+        int nbRestants = 0;
+        for (k = 0; k < n; ++k) {
+            if (sommet[k]) {
+                sommet[k] = 0;
+            } else {
+                tri[nbRestants++] = tri[k];
+            }
+        }
+        n = nbRestants;
+    }
+
+    free(tri);
+    free(chaine);
+    free(sommet);
+    return 1;
+}
+
+// ------------------Algorithme d'ajout de points en cascade-------------------
+
+/**
+ * @brief Ajoute d'un coup les points en attente **entrants** à la couche **rang** de **lst** : l'enveloppe est 
+ * recalculée avec la chaîne monotone sur ses sommets et les points entrants, en O((h + m) log(h + m)) \n
+ * Les points qui ne sont pas des sommets de la nouvelle enveloppe sont mis en attente dans l'enveloppe suivante
+ * 
+ * @param lst Répertoire des enveloppes
+ * @param rang Profondeur de l'enveloppe à mettre à jour
+ * @param entrants Points ajoutés, distincts du tableau d'attente de l'enveloppe suivante
+ */
+void fusionneCouche(ListeEnveloppes *lst, int rang, Ensemble entrants) {
+    int k;
+    ConvexHull *env_convex = lst->couches[rang];
+    int n = env_convex->curlen + entrants.nbPoints;
+    Point *points = (Point*)malloc(sizeof(Point) * n);
+    Point **tri = (Point**)malloc(sizeof(Point*) * n);
+    int *chaine = (int*)malloc(sizeof(int) * 2 * n);
+    char *sommet = (char*)calloc(n, sizeof(char));
+    if (!points || !tri || !chaine || !sommet) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+
+    // Les sommets sont recopiés avant que le polygône ne soit rendu à sa réserve
+    Vertex *v = env_convex->p;
+    for (k = 0; k < env_convex->curlen; ++k, v = v->suiv) {
+        points[k] = v->p;
+    }
+    if (!env_convex->nbMaj) {
+        majExtremesConvexHull(env_convex, entrants.tabPoints[0]);
+    }
+    for (k = 0; k < entrants.nbPoints; ++k) {
+        points[env_convex->curlen + k] = entrants.tabPoints[k];
+        majExtremes(env_convex->extremes, entrants.tabPoints[k]);
+    }
+    for (k = 0; k < n; ++k) {
+        tri[k] = &(points[k]);
+    }
+    qsort(tri, n, sizeof(Point*), comparePoints);
+
+    int lenChaine = chaineMonotone(tri, n, chaine);
+    freePolygone(&(env_convex->p), &(env_convex->reserve));
+    for (k = 0; k < lenChaine; ++k) {
+        if (!ajouteVertexPolygone(&(env_convex->p), &(env_convex->reserve), *tri[chaine[k]])) {
+            printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            exit(1);
+        }
+        sommet[chaine[k]] = 1;
+    }
+    for (k = 0; k < n; ++k) {
+        if (!sommet[k]) {
+            passeCoucheSuivante(lst, rang, *tri[k]);
+        }
+    }
+
+    // Chaque point entrant compte pour une mise à jour, comme avec ajoutePointCouche
+    env_convex->curlen = lenChaine;
+    for (k = 0; k < entrants.nbPoints; ++k) {
+        majConvexHull(env_convex);
+    }
+
+    free(points);
+    free(tri);
+    free(chaine);
+    free(sommet);
+}
+
+/**
+ * @brief Ajoute le point **p** aux enveloppes emboitées **lst** \n
+ * La cascade est itérative : chaque couche traite en une passe tous ses points en attente et 
+ * met ceux qu'elle rejette en attente dans la couche suivante, la pile ne dépend pas du nombre de couches \n
+ * A partir de **SEUIL_FUSION** points en attente, ils sont fusionnés d'un coup avec fusionneCouche 
+ * plutôt que de parcourir le polygône pour chacun
+ * 
+ * @param lst Répertoire des enveloppes, la première couche est créée si besoin
+ * @param p Point ajouté
+ */
+void majEnveloppeConvex(ListeEnveloppes *lst, Point p) {
+    ConvexHull *couche = coucheListeEnveloppes(lst, 0);
+    if (!couche) {
+        couche = allocEnveloppeConvex(lst);
+    }
+    if (!couche || !ajoutePointEnsemble(&(couche->entrants), p)) {
+        printf("\nERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        exit(1);
+    }
+
+    // Les couches créées pendant la boucle sont vues grâce à nbCouches
+    for (int rang = 0; rang < lst->nbCouches && lst->couches[rang]->entrants.nbPoints; ++rang) {
+        couche = lst->couches[rang];
+        if (couche->entrants.nbPoints >= SEUIL_FUSION) {
+            fusionneCouche(lst, rang, couche->entrants);
+        } else {
+            for (int k = 0; k < couche->entrants.nbPoints; ++k) {
+                ajoutePointCouche(lst, rang, couche->entrants.tabPoints[k]);
+            }
+        }
+        couche->entrants.nbPoints = 0;  // Le tableau est gardé pour les prochains points en attente
+    }
+}
+
+// -------------------Calcul de la profondeur d'un point--------------------
+
+/**
+ * @brief Recopie les sommets de toutes les couches de **lst** dans **index**, en O(n)
+ * 
+ * @param index Index construit, à libérer avec freeIndexProfondeur
+ * @param lst Enveloppes emboitées, l'index ne suit pas leurs modifications ultérieures
+ * @return int 1 : La construction a réussi \n
+ *             0 : Echec d'une allocation de mémoire
+ */
+int construitIndexProfondeur(IndexProfondeur *index, ListeEnveloppes *lst) {
+    int k;
+    int nbSommets = 0;
+    for (k = 0; k < lst->nbCouches; ++k) {
+        nbSommets += lst->couches[k]->curlen;
+    }
+
+    index->nbCouches = lst->nbCouches;
+    index->sommets = (Point*)malloc(sizeof(Point) * (nbSommets + 1));
+    index->debuts = (int*)malloc(sizeof(int) * (lst->nbCouches + 1));
+    if (!index->sommets || !index->debuts) {
+        free(index->sommets);
+        free(index->debuts);
+        return 0;
+    }
+
+    nbSommets = 0;
+    for (k = 0; k < lst->nbCouches; ++k) {
+        index->debuts[k] = nbSommets;
+        Vertex *v = lst->couches[k]->p;
+        for (int i = 0; i < lst->couches[k]->curlen; ++i, v = v->suiv) {
+            index->sommets[nbSommets++] = v->p;
+        }
+    }
+    index->debuts[lst->nbCouches] = nbSommets;
+    return 1;
+}
+
+/**
+ * @brief Libére la mémoire d'un index de profondeur
+ * 
+ * @param index 
+ */
+void freeIndexProfondeur(IndexProfondeur *index) {
+    free(index->sommets);
+    free(index->debuts);
+    index->sommets = NULL;
+    index->debuts = NULL;
+    index->nbCouches = 0;
+}
+
+/**
+ * @brief Détermine si **q** est dans le polygône convexe direct **s**, bord compris, sans en être un sommet, 
+ * en O(log h) : une recherche dichotomique trouve le secteur issu de s[0] contenant **q**, puis un seul côté est testé \n
+ * C'est le cas où majEnveloppeConvex fait passer **q** à la couche suivante, un polygône de deux sommets 
+ * ne contient donc que les points strictement entre ses extrémités
+ * 
+ * @param s Sommets du polygône dans le sens direct
+ * @param h Nombre de sommets
+ * @param q Point à vérifier
+ * @return int 1 : **q** est dans le polygône ou sur son bord sans en être un sommet \n
+ *             0 : **q** est à l'extérieur ou est un sommet
+ */
+int dansPolygoneConvexe(const Point *s, int h, Point q) {
+    if (h < 2) {
+        return 0;
+    }
+    if (h == 2) {
+        return orientation(s[0], s[1], q) == 0 && ordrePoints(q, s[0]) * ordrePoints(q, s[1]) < 0;
+    }
+
+    // Dans le sens direct, l'intérieur est du côté où orientation est négative
+    if (orientation(s[0], s[1], q) > 0 || orientation(s[h - 1], s[0], q) > 0) {
+        return 0;
+    }
+    int bas = 1;
+    int haut = h - 1;
+    while (haut - bas > 1) {
+        int milieu = (bas + haut) / 2;
+        if (orientation(s[0], s[milieu], q) <= 0) {
+            bas = milieu;
+        } else {
+            haut = milieu;
+        }
+    }
+    if (orientation(s[bas], s[haut], q) > 0) {
+        return 0;
+    }
+    // Un sommet égal à q borne forcément le secteur trouvé
+    return ordrePoints(q, s[0]) && ordrePoints(q, s[bas]) && ordrePoints(q, s[haut]);
+}
+
+/**
+ * @brief Renvoie la profondeur de **q** dans les couches de **index** sans l'ajouter, c'est à dire le nombre 
+ * de couches qui le contiennent, bord compris, sans l'avoir pour sommet : un point de l'ensemble a pour profondeur 
+ * le numéro de sa couche, un autre point celui de la couche qui le recevrait avec majEnveloppeConvex \n
+ * Les couches étant emboitées, les couches contenant **q** sont les premières : la profondeur est 
+ * trouvée par recherche dichotomique sur les couches, en O(log L log h)
+ * 
+ * @param index Index des couches
+ * @param q Point dont on veut la profondeur
+ * @return int Profondeur de **q**, 0 si il est hors de l'enveloppe de tous les points ou un de ses sommets
+ */
+int profondeurPoint(const IndexProfondeur *index, Point q) {
+    int bas = 0;
+    int haut = index->nbCouches;
+    while (bas < haut) {
+        int milieu = (bas + haut) / 2;
+        int debut = index->debuts[milieu];
+        if (dansPolygoneConvexe(&(index->sommets[debut]), index->debuts[milieu + 1] - debut, q)) {
+            bas = milieu + 1;
+        } else {
+            haut = milieu;
+        }
+    }
+    return bas;
+}
+
+/**
+ * @brief Calcule la profondeur de chacun des points de **e** avec profondeurPoint
+ * 
+ * @param index Index des couches
+ * @param e Points dont on veut la profondeur
+ * @param profondeurs Tableau d'au moins e.nbPoints places, reçoit la profondeur de chaque point
+ */
+void profondeursEnsemble(const IndexProfondeur *index, Ensemble e, int *profondeurs) {
+    for (int k = 0; k < e.nbPoints; ++k) {
+        profondeurs[k] = profondeurPoint(index, e.tabPoints[k]);
+    }
+}
+
 // -------------------Fonctions gestions interface graphique-------------------
 
 /**
@@ -460,10 +1344,6 @@ MLV_Event actualiseSouris(Point *souris){
     if (event_type == MLV_MOUSE_BUTTON) {
         souris->x = (double)souris_x;
         souris->y = (double)souris_y;
-
-        // Ajout d'une petite fluctuation pour ne pas avoir deux points superposées
-        souris->x += (double)rand() / RAND_MAX;
-        souris->y += (double)rand() / RAND_MAX;
     }
     
     return event_type;
@@ -488,12 +1368,12 @@ void dessineEnsemble(Ensemble e, MLV_Color couleur) {
  */
 void dessinePolygone(Polygone poly, MLV_Color couleur) {
     Vertex *tete = poly;
-    MLV_draw_filled_circle((int)poly->p->x, (int)poly->p->y, 1, couleur);
-    MLV_draw_line((int)poly->p->x, (int)poly->p->y, (int)poly->suiv->p->x, (int)poly->suiv->p->y, couleur);
+    MLV_draw_filled_circle((int)poly->p.x, (int)poly->p.y, 1, couleur);
+    MLV_draw_line((int)poly->p.x, (int)poly->p.y, (int)poly->suiv->p.x, (int)poly->suiv->p.y, couleur);
     poly = poly->suiv;
     for (; poly != tete; poly = poly->suiv) {
-        MLV_draw_filled_circle((int)poly->p->x, (int)poly->p->y, 1, couleur);
-        MLV_draw_line((int)poly->p->x, (int)poly->p->y, (int)poly->suiv->p->x, (int)poly->suiv->p->y, couleur);
+        MLV_draw_filled_circle((int)poly->p.x, (int)poly->p.y, 1, couleur);
+        MLV_draw_line((int)poly->p.x, (int)poly->p.y, (int)poly->suiv->p.x, (int)poly->suiv->p.y, couleur);
     }
 }
 
@@ -502,9 +1382,9 @@ void dessineListeEnveloppe(ListeEnveloppes l) {
     float r = 255, g = 0, b = 0;
     MLV_Color couleur = MLV_rgba(r, g, b, 255);
 
-    for (; l; l = l->suiv) {
-        if (l->curlen > 2) {
-            dessinePolygone(l->p, couleur);
+    for (int k = 0; k < l.nbCouches; ++k) {
+        if (l.couches[k]->curlen > 2) {
+            dessinePolygone(l.couches[k]->p, couleur);
         }
 
         // Gradiant de couleur qui part du rouge pour tendre vers le bleu
@@ -566,9 +1446,7 @@ Point generationPoint(int centre, int rayon, int forme) {
  * 
  */
 void mainEnveloppeSouris() {
-    int l = 0;
-    ListeEnveloppes lst_env_convex = allocEnveloppeConvex();
-    *lst_env_convex = initConvexHull();  // initialise la première enveloppe
+    ListeEnveloppes lst_env_convex = initListeEnveloppes();  // La première enveloppe est créée au premier point
 
     Point *tabPoints = (Point*)calloc(BLOC, sizeof(Point));
 
@@ -591,24 +1469,10 @@ void mainEnveloppeSouris() {
             exit(1);
         }
 
-        // Si on a réalloué la mémoire il faut rediriger les pointeurs de l'enveloppe convexe vers la nouvelle zone mémoire
-        if (!((e.nbPoints - 1) % (BLOC))) {
-            freeListeEnveloppeConvex(&lst_env_convex);
-            lst_env_convex = allocEnveloppeConvex();
-            *lst_env_convex = initConvexHull();
-            for (l = 0; l < e.nbPoints; ++l) {
-                majEnveloppeConvex(lst_env_convex, &(e.tabPoints[l]));
-            }
-        } else {  // Sinon on met à jour juste avec le dernier point ajouter
-            majEnveloppeConvex(lst_env_convex, &(e.tabPoints[e.nbPoints - 1]));
-        }
+        // Les sommets des enveloppes ont leur propre copie du point, une réallocation de l'ensemble ne les concerne pas
+        majEnveloppeConvex(&lst_env_convex, e.tabPoints[e.nbPoints - 1]);
 
-        printf("ENVELOPPE CONVEXE INFO :\n");
-        printf("    curlen = %d \n", lst_env_convex->curlen);
-        printf("    maxlen = %d \n", lst_env_convex->maxlen);
-        printf("    avg = %f \n", lst_env_convex->avg);
-        printf("    nbMaj = %d \n", lst_env_convex->nbMaj);
-        printf("\n");
+        printInfoConvexHull(*lst_env_convex.couches[0]);
 
         dessineEnsemble(e, MLV_COLOR_BLUE);
         dessineListeEnveloppe(lst_env_convex);
@@ -644,11 +1508,14 @@ void mainEnveloppeSouris() {
  * 
  */
 void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int spiral, int dynamique) {
-    ListeEnveloppes lst_env_convex = allocEnveloppeConvex();
-    *lst_env_convex = initConvexHull();  // initialise la première enveloppe
+    ListeEnveloppes lst_env_convex = initListeEnveloppes();  // La première enveloppe est créée au premier point
 
-    Point *tabPoints = (Point*)malloc(nbPoints * sizeof(Point));
-    Ensemble e = initEnsemble(tabPoints, nbPoints);
+    // Tous les points sont connus à l'avance, le tableau est dimensionné une seule fois
+    Ensemble e = initEnsemble(NULL, 0);
+    if (!reserveEnsemble(&e, nbPoints)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+        exit(1);
+    }
 
     MLV_Keyboard_button sym = MLV_KEYBOARD_NONE;  // Récupére les potentielles entrées de touches
     int longueur_fen = 500;
@@ -674,13 +1541,14 @@ void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int s
             exit(1);
         }
 
-        majEnveloppeConvex(lst_env_convex, &(e.tabPoints[k]));
-
         if (spiral) {
             rayon += pas;
         }
 
+        // Sans affichage dynamique les enveloppes ne sont calculées qu'une fois tous les points générés
         if (dynamique) {
+            majEnveloppeConvex(&lst_env_convex, e.tabPoints[k]);
+
             dessineEnsemble(e, MLV_COLOR_BLUE);
             dessineListeEnveloppe(lst_env_convex);
 
@@ -696,6 +1564,14 @@ void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int s
         k++;
     }
 
+    // Si l'affichage dynamique a été coupé, on calcule les enveloppes de tout l'ensemble d'un coup
+    if (!dynamique) {
+        if (!peleEnveloppesEnsemble(&lst_env_convex, e)) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME");
+            exit(1);
+        }
+    }
+
     dessineEnsemble(e, MLV_COLOR_BLUE);
     dessineListeEnveloppe(lst_env_convex);
 
@@ -711,6 +1587,98 @@ void mainEnveloppeForme(int centre, double rayon, int nbPoints, int forme, int s
     freeListeEnveloppeConvex(&lst_env_convex);
 }
 
+/**
+ * @brief Affiche la profondeur dans les couches **lst** de chacun des points lus dans **requetes**, 
+ * un entier par ligne dans l'ordre de lecture
+ * 
+ * @param lst Enveloppes emboitées
+ * @param requetes Fichier contenant les points, deux coordonnées par ligne
+ * @return int 0 : Succès \n
+ *             1 : Echec d'une allocation de mémoire
+ */
+int mainProfondeurs(ListeEnveloppes *lst, FILE *requetes) {
+    IndexProfondeur index;
+    Ensemble q = initEnsemble(NULL, 0);
+    if (!construitIndexProfondeur(&index, lst)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        return 1;
+    }
+    int *profondeurs = NULL;
+    if (!lectureEnsemble(requetes, &q) || !(profondeurs = (int*)malloc(sizeof(int) * (q.nbPoints + 1)))) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        free(q.tabPoints);
+        freeIndexProfondeur(&index);
+        return 1;
+    }
+
+    profondeursEnsemble(&index, q, profondeurs);
+    for (int k = 0; k < q.nbPoints; ++k) {
+        printf("%d\n", profondeurs[k]);
+    }
+
+    free(profondeurs);
+    free(q.tabPoints);
+    freeIndexProfondeur(&index);
+    return 0;
+}
+
+/**
+ * @brief Calcule sans fenêtre MLV les enveloppes convexes emboitées des points 
+ * lus dans **f** puis affiche les sommets et les informations de chaque enveloppe
+ * 
+ * @param f Fichier contenant les points, deux coordonnées par ligne
+ * @param batch 1 : Calcul des couches en une seule fois avec peleEnveloppesEnsemble \n
+ *              0 : Ajout point par point avec majEnveloppeConvex
+ * @param requetes Si il n'est pas NULL, fichier de points dont on affiche la profondeur (un entier par ligne) 
+ *                 à la place des enveloppes, sans les ajouter
+ * @return int 0 : Succès \n
+ *             1 : Echec d'une allocation de mémoire
+ */
+int mainEnveloppeFichier(FILE *f, int batch, FILE *requetes) {
+    ListeEnveloppes lst_env_convex = initListeEnveloppes();
+
+    Point *tabPoints = (Point*)malloc(BLOC * sizeof(Point));
+    Ensemble e = initEnsemble(tabPoints, BLOC);
+    if (!tabPoints || !lectureEnsemble(f, &e)) {
+        printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+        free(e.tabPoints);
+        freeListeEnveloppeConvex(&lst_env_convex);
+        return 1;
+    }
+
+    if (batch) {
+        if (!peleEnveloppesEnsemble(&lst_env_convex, e)) {
+            printf("ERREUR LORS DE L'ALLOCATION DE LA MEMOIRE FIN DU PROGRAMME\n");
+            free(e.tabPoints);
+            freeListeEnveloppeConvex(&lst_env_convex);
+            return 1;
+        }
+    } else {
+        for (int k = 0; k < e.nbPoints; ++k) {
+            majEnveloppeConvex(&lst_env_convex, e.tabPoints[k]);
+        }
+    }
+
+    if (requetes) {
+        int retour = mainProfondeurs(&lst_env_convex, requetes);
+        free(e.tabPoints);
+        freeListeEnveloppeConvex(&lst_env_convex);
+        return retour;
+    }
+
+    for (int k = 0; k < lst_env_convex.nbCouches; ++k) {
+        printf("ENVELOPPE %d :\n", k);
+        printPolygone(lst_env_convex.couches[k]->p);
+        printf("\n");
+        printInfoConvexHull(*lst_env_convex.couches[k]);
+    }
+
+    // Libération de la mémoire
+    free(e.tabPoints);
+    freeListeEnveloppeConvex(&lst_env_convex);
+    return 0;
+}
+
 // ------------------------------------Menu------------------------------------
 
 /**
@@ -915,9 +1883,83 @@ void menu2(int largeurFen, int hauteurFen, int *nbPoints, int *dynamique, int *f
 
 // ----------------------------Programme principale----------------------------
 
-int main(void) {
+/**
+ * @brief Lit les arguments de la ligne de commande et lance le calcul sans fenêtre \n
+ * Utilisation : ./a.out [-m incremental|batch] [-q requetes] fichier (- pour l'entrée standard)
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int Code de retour du programme
+ */
+int mainSansFenetre(int argc, char *argv[]) {
+    int batch = 0;
+    char *nomFichier = NULL;
+    char *nomRequetes = NULL;
+
+    for (int k = 1; k < argc; ++k) {
+        if (!strcmp(argv[k], "-m") && k + 1 < argc) {
+            k++;
+            if (!strcmp(argv[k], "incremental")) {
+                batch = 0;
+            } else if (!strcmp(argv[k], "batch")) {
+                batch = 1;
+            } else {
+                fprintf(stderr, "Moteur inconnu : %s\n", argv[k]);
+                return 2;
+            }
+        } else if (!strcmp(argv[k], "-q") && k + 1 < argc) {
+            nomRequetes = argv[++k];
+        } else if (!nomFichier) {
+            nomFichier = argv[k];
+        } else {
+            nomFichier = NULL;
+            break;
+        }
+    }
+    if (!nomFichier) {
+        fprintf(stderr, "Utilisation : %s [-m incremental|batch] [-q requetes] fichier (- pour l'entrée standard)\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = stdin;
+    if (strcmp(nomFichier, "-")) {
+        f = fopen(nomFichier, "r");
+        if (!f) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+            return 1;
+        }
+    }
+
+    FILE *requetes = NULL;
+    if (nomRequetes) {
+        requetes = fopen(nomRequetes, "r");
+        if (!requetes) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", nomRequetes);
+            if (f != stdin) {
+                fclose(f);
+            }
+            return 1;
+        }
+    }
+
+    int retour = mainEnveloppeFichier(f, batch, requetes);
+    if (f != stdin) {
+        fclose(f);
+    }
+    if (requetes) {
+        fclose(requetes);
+    }
+    return retour;
+}
+
+int main(int argc, char *argv[]) {
     srand(time(NULL));
 
+    // Avec des arguments le calcul se fait sans fenêtre (fichier de points ou entrée standard)
+    if (argc > 1) {
+        return mainSansFenetre(argc, argv);
+    }
+
     // Pour quitter le programme l'utilisateur doit appuyer sur echap ou fermer la fenêtre
     while (1) {
         int dynamique = 0;  // Affichaque dynamique ou seulement rendu final